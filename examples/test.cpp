@@ -53,16 +53,18 @@ int main(void) {
         // Add the action to a BufferedInput so that it can be automatically pumped
         input.actions["shoot"] = std::move(a); // NOTE: Actions are move only!
     }
-    // It is also possible to extract the last state (as calculated last time BufferedInput.PollEvents was called)
-    std::cout << (bool)input.actions["shoot"].data.button.last_state << std::endl;
+    // It is also possible to read the state of actions directly (as calculated last time BufferedInput.PollEvents was called)
+    // Requesting a handle mirrors the action's state into arrays which can be read in bulk (ex. by an ECS system)
+    auto shoot = input.GetHandle("shoot");
+    std::cout << input.GetState(shoot).down << std::endl;
 
     // Main game loop
     while (!WindowShouldClose()) {    // Detect window close button or ESC key
         // Processing and callback invocation occur whenever messages are pumped
         input.PollEvents();
 
-        // NOTE: Be careful to access the correct union alternative when extracting the last state
-        std::cout << (bool)input.actions["shoot"].data.button.last_state << std::endl;
+        // Pressed and released are only true for the poll where the state changed
+        if(input.GetState(shoot).pressed) std::cout << "Shoot pressed this frame!" << std::endl;
 
 
         // Draw
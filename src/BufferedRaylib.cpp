@@ -2,17 +2,388 @@
 
 #include "raymath.h"
 
+#ifdef BUFFERED_RAYLIB_GLFW_HOOKS
+	#include "GLFW/glfw3.h"
+#endif
+
 #include <set>
 #include <string>
 #include <string_view>
 #include <map>
 #include <array>
 #include <concepts>
+#include <cassert>
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+#ifdef BUFFERED_RAYLIB_TRACING
+	#include <atomic>
+	#include <cstdio>
+	#include <mutex>
+#endif
 
 namespace raylib {
 
+#ifdef BUFFERED_RAYLIB_GLFW_HOOKS
+	namespace hooks {
+		static GLFWwindow* window = nullptr;
+		static GLFWscrollfun raylibScroll = nullptr;
+		static GLFWcursorposfun raylibCursor = nullptr;
+
+		// Mouse motion is summed in doubles so that many small (raw) motion events don't lose precision
+		static GLFWHooks::Totals totals;
+		static double cursorX = 0, cursorY = 0;
+		static int cursorMode = 0;
+		static std::array<double, GLFWHooks::EventHistory> eventTimes; // Ring of the times of the most recent events (indexed by event % EventHistory)
+
+		static void MarkEvent() {
+			eventTimes[totals.events++ % eventTimes.size()] = GetTime();
+		}
+
+		static void Scroll(GLFWwindow* window, double x, double y) {
+			totals.wheelX += x;
+			totals.wheelY += y;
+			MarkEvent();
+			if(raylibScroll) raylibScroll(window, x, y);
+		}
+
+		static void Cursor(GLFWwindow* window, double x, double y) {
+			// Disabling or enabling the cursor warps it, that jump isn't motion
+			if(int mode = glfwGetInputMode(window, GLFW_CURSOR); mode == cursorMode) {
+				totals.deltaX += x - cursorX;
+				totals.deltaY += y - cursorY;
+				MarkEvent();
+			} else cursorMode = mode;
+			cursorX = x;
+			cursorY = y;
+			if(raylibCursor) raylibCursor(window, x, y);
+		}
+	}
+
+	bool GLFWHooks::Install(bool rawMouseMotion /*= false*/) {
+		if(hooks::window) return true;
+		hooks::window = (GLFWwindow*)GetWindowHandle();
+		if(!hooks::window) return false;
+
+		hooks::raylibScroll = glfwSetScrollCallback(hooks::window, hooks::Scroll);
+
+		ResetMouseDelta();
+		hooks::raylibCursor = glfwSetCursorPosCallback(hooks::window, hooks::Cursor);
+		if(rawMouseMotion && glfwRawMouseMotionSupported())
+			glfwSetInputMode(hooks::window, GLFW_RAW_MOUSE_MOTION, GLFW_TRUE);
+		return true;
+	}
+
+	void GLFWHooks::Uninstall() {
+		if(!hooks::window) return;
+		glfwSetScrollCallback(hooks::window, hooks::raylibScroll);
+		glfwSetCursorPosCallback(hooks::window, hooks::raylibCursor);
+		hooks::window = nullptr;
+	}
+
+	bool GLFWHooks::Installed() { return hooks::window; }
+
+	GLFWHooks::Totals GLFWHooks::GetTotals() { return hooks::totals; }
+
+	double GLFWHooks::GetEventTime(uint64_t event) {
+		if(event >= hooks::totals.events) return -1;
+		event = std::max(event, hooks::totals.events - std::min<uint64_t>(hooks::totals.events, EventHistory));
+		return hooks::eventTimes[event % EventHistory];
+	}
+
+	void GLFWHooks::ResetMouseDelta() {
+		if(!hooks::window) return;
+		glfwGetCursorPos(hooks::window, &hooks::cursorX, &hooks::cursorY);
+		hooks::cursorMode = glfwGetInputMode(hooks::window, GLFW_CURSOR);
+		hooks::totals.resetX = hooks::totals.deltaX;
+		hooks::totals.resetY = hooks::totals.deltaY;
+		hooks::totals.resets++;
+	}
+#else
+	bool GLFWHooks::Install(bool rawMouseMotion /*= false*/) { return false; }
+	void GLFWHooks::Uninstall() {}
+	bool GLFWHooks::Installed() { return false; }
+	GLFWHooks::Totals GLFWHooks::GetTotals() { return {}; }
+	double GLFWHooks::GetEventTime(uint64_t event) { return -1; }
+	void GLFWHooks::ResetMouseDelta() {}
+#endif
+
+#ifdef BUFFERED_RAYLIB_TRACING
+	namespace tracing {
+		struct Span {
+			const char* category;
+			char name[48];
+			int64_t start, end;
+		};
+
+		// Single producer (the owning thread) single consumer (Flush) ring of spans
+		struct Buffer {
+			std::unique_ptr<Span[]> spans = std::make_unique<Span[]>(Tracer::Capacity);
+			std::atomic<uint64_t> head = 0, tail = 0;
+			uint32_t thread;
+		};
+
+		static std::mutex mutex; // Guards the file and the list of buffers (never taken while recording once a thread has its buffer)
+		static std::vector<std::unique_ptr<Buffer>> buffers; // Buffers outlive their threads so that their last spans still get flushed
+		static std::FILE* file = nullptr;
+		static std::atomic<bool> open = false;
+		static bool first = true;
+
+		static Buffer& Local() {
+			thread_local Buffer* local = nullptr;
+			if(!local) {
+				std::scoped_lock lock(mutex);
+				local = buffers.emplace_back(std::make_unique<Buffer>()).get();
+				local->thread = buffers.size();
+			}
+			return *local;
+		}
+
+		static void WriteEscaped(const char* string) {
+			for(; *string; string++)
+				if(*string == '"' || *string == '\\') std::fprintf(file, "\\%c", *string);
+				else if((unsigned char)*string < 0x20) std::fprintf(file, "\\u%04x", *string);
+				else std::fputc(*string, file);
+		}
+	}
+
+	bool Tracer::Open(const char* path) {
+		Close();
+		std::scoped_lock lock(tracing::mutex);
+		tracing::file = std::fopen(path, "w");
+		if(!tracing::file) return false;
+		std::fputs("{\"traceEvents\":[\n", tracing::file);
+		tracing::first = true;
+		tracing::open = true;
+		return true;
+	}
+
+	void Tracer::Flush() {
+		std::scoped_lock lock(tracing::mutex);
+		if(!tracing::file) return;
+		for(auto& buffer: tracing::buffers) {
+			uint64_t tail = buffer->tail.load(std::memory_order_relaxed), head = buffer->head.load(std::memory_order_acquire);
+			for(; tail < head; tail++) {
+				auto& span = buffer->spans[tail % Capacity];
+				std::fprintf(tracing::file, "%s{\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"cat\":\"%s\",\"name\":\"", tracing::first ? "" : ",\n", buffer->thread, span.category);
+				tracing::WriteEscaped(span.name[0] ? span.name : span.category);
+				std::fprintf(tracing::file, "\",\"ts\":%.3f,\"dur\":%.3f}", span.start / 1000.0, (span.end - span.start) / 1000.0);
+				tracing::first = false;
+			}
+			buffer->tail.store(head, std::memory_order_release);
+		}
+		std::fflush(tracing::file);
+	}
+
+	void Tracer::Close() {
+		if(!IsOpen()) return;
+		tracing::open = false;
+		Flush();
+		std::scoped_lock lock(tracing::mutex);
+		std::fputs("\n]}\n", tracing::file);
+		std::fclose(tracing::file);
+		tracing::file = nullptr;
+	}
+
+	bool Tracer::IsOpen() { return tracing::open.load(std::memory_order_relaxed); }
+
+	void Tracer::Record(const char* category, std::string_view name, int64_t start, int64_t end) {
+		if(!IsOpen()) return;
+		auto& buffer = tracing::Local();
+		uint64_t head = buffer.head.load(std::memory_order_relaxed);
+		if(head - buffer.tail.load(std::memory_order_acquire) >= Capacity) return; // Full, drop the span
+
+		auto& span = buffer.spans[head % Capacity];
+		span.category = category;
+		size_t length = std::min(name.size(), sizeof(span.name) - 1);
+		std::copy_n(name.data(), length, span.name);
+		span.name[length] = '\0';
+		span.start = start;
+		span.end = end;
+		buffer.head.store(head + 1, std::memory_order_release);
+	}
+#else
+	bool Tracer::Open(const char* path) { return false; }
+	void Tracer::Flush() {}
+	void Tracer::Close() {}
+	bool Tracer::IsOpen() { return false; }
+	void Tracer::Record(const char* category, std::string_view name, int64_t start, int64_t end) {}
+#endif
+
+	InputSnapshot& InputSnapshot::Capture() {
+		keys.reset();
+		for(int key = 0; key <= KEY_KB_MENU; key++)
+			if(::IsKeyDown(key)) keys.set(key);
+
+		mouseButtons.reset();
+		for(int button = MOUSE_BUTTON_LEFT; button <= MOUSE_BUTTON_BACK; button++)
+			if(::IsMouseButtonDown(button)) mouseButtons.set(button);
+		mousePosition = GetMousePosition();
+		double hookedTime = -1;
+		if(GLFWHooks::Installed() && hookedPrimed) {
+			// The hooks keep running totals, so this snapshot reports what changed since its own last capture
+			auto now = GLFWHooks::GetTotals();
+			double fromX = hooked.resets == now.resets ? hooked.deltaX : now.resetX;
+			double fromY = hooked.resets == now.resets ? hooked.deltaY : now.resetY;
+			mouseDelta = {float(now.deltaX - fromX), float(now.deltaY - fromY)};
+			mouseWheel = {float(now.wheelX - hooked.wheelX), float(now.wheelY - hooked.wheelY)};
+			hookedTime = GLFWHooks::GetEventTime(hooked.events);
+			hooked = now;
+		} else {
+			mouseDelta = GetMouseDelta();
+			mouseWheel = GetMouseWheelMoveV();
+			// The first capture after the hooks are installed only marks where this snapshot starts reading them
+			if((hookedPrimed = GLFWHooks::Installed())) hooked = GLFWHooks::GetTotals();
+		}
+
+		for(int gamepad = 0; gamepad < (int)MaxGamepads; gamepad++)
+			gamepads[gamepad].Capture(gamepad);
+
+		UpdateThresholds();
+		focused = IsWindowFocused();
+		time = GetTime();
+		eventTime = hookedTime >= 0 ? std::min(hookedTime, time) : time;
+		return *this;
+	}
+
+	// Marks a button as pressed in a snapshot (the opposite of ReleaseButton)
+	static void PressButton(InputSnapshot& snapshot, const Button& button) {
+		switch(button.type) {
+		break; case Button::Type::Keyboard:
+			if(button.keyboard >= 0 && button.keyboard < (int)InputSnapshot::MaxKeyboardKeys)
+				snapshot.keys.set(button.keyboard);
+		break; case Button::Type::Mouse:
+			if(button.mouse >= 0 && button.mouse < (int)InputSnapshot::MaxMouseButtons)
+				snapshot.mouseButtons.set(button.mouse);
+		break; case Button::Type::Gamepad:
+			if(button.gamepad.id >= 0 && button.gamepad.id < (int)InputSnapshot::MaxGamepads && button.gamepad.button >= 0 && button.gamepad.button < (int)InputSnapshot::MaxGamepadButtons)
+				snapshot.gamepads[button.gamepad.id].buttons |= uint32_t(1) << button.gamepad.button;
+		break; case Button::Type::Threshold:
+			if(button.threshold < InputSnapshot::MaxThresholds)
+				snapshot.thresholds.set(button.threshold);
+		break; default: break;
+		}
+	}
+
+	InputSnapshot& InputSnapshot::Capture(const Action& action) {
+		action.VisitButtons([this](const Button& button) {
+			if(Button::IsPressed(button)) PressButton(*this, button);
+			else ReleaseButton(*this, button);
+		});
+
+		auto readAxis = [this](int gamepad, GamepadAxis axis) {
+			if(gamepad < 0 || gamepad >= (int)MaxGamepads || axis < 0 || axis >= (int)MaxGamepadAxes) return;
+			gamepads[gamepad].axes[axis] = ::GetGamepadAxisMovement(gamepad, axis);
+			gamepads[gamepad].axisCount = std::max<uint8_t>(gamepads[gamepad].axisCount, axis + 1);
+		};
+		using Axis = Action::Data::Axis;
+		using Vector = Action::Data::Vector;
+		if(action.type == Action::Type::Axis) switch(action.data.axis.type) {
+		break; case Axis::Type::Gamepad:
+			readAxis(action.data.axis.gamepad.id, action.data.axis.gamepad.axis);
+		break; case Axis::Type::MouseWheel:
+			mouseWheel = GetMouseWheelMoveV();
+		break; default: break;
+		}
+		else if(action.type == Action::Type::Vector) switch(action.data.vector.type) {
+		break; case Vector::Type::MouseWheel:
+			mouseWheel = GetMouseWheelMoveV();
+		break; case Vector::Type::MousePosition:
+			mousePosition = GetMousePosition();
+		break; case Vector::Type::MouseDelta:
+			mouseDelta = GetMouseDelta();
+		break; case Vector::Type::GamepadAxes: case Vector::Type::GamepadDirection:
+			readAxis(action.data.vector.gamepad.horizontal.id, action.data.vector.gamepad.horizontal.axis);
+			readAxis(action.data.vector.gamepad.vertical.id, action.data.vector.gamepad.vertical.axis);
+		break; default: break;
+		}
+
+		focused = IsWindowFocused();
+		time = eventTime = GetTime();
+		return *this;
+	}
+
+	InputSnapshot& InputSnapshot::RemapFrom(const InputSnapshot& source, const GamepadMapping& mapping) {
+		assert(&source != this);
+		// The source evaluated the thresholds against other gamepads, so they are reevaluated from this snapshot's own history
+		auto previous = thresholds;
+		*this = source;
+		for(size_t gamepad = 0; gamepad < MaxGamepads; gamepad++)
+			if(int physical = mapping[gamepad]; physical >= 0 && physical < (int)MaxGamepads)
+				gamepads[gamepad] = source.gamepads[physical];
+			else gamepads[gamepad] = {};
+		thresholds = previous;
+		UpdateThresholds();
+		return *this;
+	}
+
+	bool InputSnapshot::IsIdleSince(const InputSnapshot& previous) const {
+		return mouseDelta.x == 0 && mouseDelta.y == 0 && mouseWheel.x == 0 && mouseWheel.y == 0
+			&& keys == previous.keys && mouseButtons == previous.mouseButtons && thresholds == previous.thresholds
+			&& mousePosition.x == previous.mousePosition.x && mousePosition.y == previous.mousePosition.y
+			&& gamepads == previous.gamepads && focused == previous.focused;
+	}
+
+	// Thresholds are registered while bindings are created (possibly on several threads), identical thresholds share a bit.
+	// Registered thresholds never change, so readers only need to load the count
+	struct ThresholdRegistry {
+		std::array<InputSnapshot::AxisThreshold, InputSnapshot::MaxThresholds> thresholds;
+		std::atomic<size_t> size = 0;
+		std::mutex mutex; // Held while registering
+
+		static ThresholdRegistry& Get() {
+			static ThresholdRegistry registry;
+			return registry;
+		}
+	};
+
+	uint16_t InputSnapshot::RegisterThreshold(const AxisThreshold& threshold) {
+		auto& registry = ThresholdRegistry::Get();
+		std::scoped_lock lock(registry.mutex);
+		size_t size = registry.size.load(std::memory_order_relaxed);
+		if(auto found = std::find(registry.thresholds.begin(), registry.thresholds.begin() + size, threshold); found != registry.thresholds.begin() + size)
+			return found - registry.thresholds.begin();
+		if(size >= MaxThresholds) {
+			TraceLog(LOG_ERROR, "INPUT: Too many distinct axis thresholds (at most %d), the threshold will never be pressed", (int)MaxThresholds);
+			assert(false && "Too many distinct thresholds");
+			return InvalidThreshold;
+		}
+		registry.thresholds[size] = threshold;
+		registry.size.store(size + 1, std::memory_order_release);
+		return size;
+	}
+
+	std::span<const InputSnapshot::AxisThreshold> InputSnapshot::RegisteredThresholds() {
+		auto& registry = ThresholdRegistry::Get();
+		return {registry.thresholds.data(), registry.size.load(std::memory_order_acquire)};
+	}
+
+	void InputSnapshot::UpdateThresholds() {
+		auto registry = RegisteredThresholds();
+		for(size_t i = 0; i < registry.size(); i++)
+			thresholds[i] = registry[i].Evaluate(GetGamepadAxisMovement(registry[i].gamepad, registry[i].axis), thresholds[i]);
+	}
+
+	InputSnapshot::GamepadState& InputSnapshot::GamepadState::Capture(int gamepad) {
+		if(!::IsGamepadAvailable(gamepad))
+			return *this = {};
+
+		available = true;
+		buttons = 0;
+		for(int button = GAMEPAD_BUTTON_LEFT_FACE_UP; button <= GAMEPAD_BUTTON_RIGHT_THUMB; button++)
+			buttons |= uint32_t(::IsGamepadButtonDown(gamepad, button)) << button;
+
+		axisCount = std::clamp(GetGamepadAxisCount(gamepad), 0, (int)MaxGamepadAxes);
+		for(int axis = 0; axis < axisCount; axis++)
+			axes[axis] = ::GetGamepadAxisMovement(gamepad, axis);
+		std::fill(axes.begin() + axisCount, axes.end(), 0);
+		return *this;
+	}
+
 	bool Button::operator<(const Button& o) const {
 		if (type != o.type) return type < o.type;
+		if (type == Type::Threshold) return threshold < o.threshold;
 		if (type == Type::Gamepad && gamepad.id == o.gamepad.id)
 			return gamepad.button < o.gamepad.button;
 		return keyboard < o.keyboard; // They should all be castable to a keyboard key, thus comparing only it should be fine!
@@ -27,11 +398,50 @@ namespace raylib {
 		break; case Button::Type::Gamepad: {
 			return IsGamepadButtonDown(button.gamepad.id, button.gamepad.button);
 		}
+		break; case Button::Type::Threshold: {
+			auto registry = InputSnapshot::RegisteredThresholds();
+			if(button.threshold >= registry.size()) return false;
+			auto& threshold = registry[button.threshold];
+			return threshold.Evaluate(GetGamepadAxisMovement(threshold.gamepad, threshold.axis), false);
+		}
+		break; default: assert(button.type != Button::Type::Invalid);
+		}
+		return false;
+	}
+
+	bool Button::IsPressed(const Button& button, const InputSnapshot& snapshot) {
+		switch(button.type) {
+		break; case Button::Type::Keyboard:
+			return snapshot.IsKeyDown(button.keyboard);
+		break; case Button::Type::Mouse:
+			return snapshot.IsMouseButtonDown(button.mouse);
+		break; case Button::Type::Gamepad:
+			return snapshot.IsGamepadButtonDown(button.gamepad.id, button.gamepad.button);
+		break; case Button::Type::Threshold:
+			return snapshot.IsThresholdDown(button.threshold);
 		break; default: assert(button.type != Button::Type::Invalid);
 		}
 		return false;
 	}
 
+	void ReleaseButton(InputSnapshot& snapshot, const Button& button) {
+		switch(button.type) {
+		break; case Button::Type::Keyboard:
+			if(button.keyboard >= 0 && button.keyboard < (int)InputSnapshot::MaxKeyboardKeys)
+				snapshot.keys.reset(button.keyboard);
+		break; case Button::Type::Mouse:
+			if(button.mouse >= 0 && button.mouse < (int)InputSnapshot::MaxMouseButtons)
+				snapshot.mouseButtons.reset(button.mouse);
+		break; case Button::Type::Gamepad:
+			if(button.gamepad.id >= 0 && button.gamepad.id < (int)InputSnapshot::MaxGamepads && button.gamepad.button >= 0 && button.gamepad.button < (int)InputSnapshot::MaxGamepadButtons)
+				snapshot.gamepads[button.gamepad.id].buttons &= ~(uint32_t(1) << button.gamepad.button);
+		break; case Button::Type::Threshold:
+			if(button.threshold < InputSnapshot::MaxThresholds)
+				snapshot.thresholds.reset(button.threshold);
+		break; default: break;
+		}
+	}
+
 	uint8_t Button::IsSetPressed(const std::set<Button>& buttons) {
 		uint8_t state = 0;
 		for(auto& button: buttons)
@@ -39,65 +449,327 @@ namespace raylib {
 		return state;
 	}
 
+	uint8_t Button::IsSetPressed(const std::set<Button>& buttons, const InputSnapshot& snapshot) {
+		uint8_t state = 0;
+		for(auto& button: buttons)
+			state += IsPressed(button, snapshot);
+		return state;
+	}
+
+	void Action::DeleteBindings() {
+		if(type == Type::Button && data.button.buttons) delete data.button.buttons;
+		else if(type == Type::MultiButton && data.multi.type == Data::MultiButton::Type::OctButtons && data.multi.octButtons) delete data.multi.octButtons;
+		else if(type == Type::MultiButton && data.multi.quadButtons) delete data.multi.quadButtons;
+		else if(type == Type::Derived && data.derived.derived) delete data.derived.derived;
+	}
+
 	Action& Action::operator=(Action&& o) {
+		if(this == &o) return *this;
+		DeleteBindings();
 		type = o.type;
 		data = std::move(o.data);
 		callback = std::move(o.callback);
+		processor = std::move(o.processor);
+		interaction = std::move(o.interaction);
+		if(interaction) interaction->owner = this;
+		repeat = std::move(o.repeat);
+		if(repeat) repeat->owner = this;
 		if(o.type == Type::Button) data.button.buttons = std::exchange(o.data.button.buttons, nullptr);
+		else if(o.type == Type::MultiButton && o.data.multi.type == Data::MultiButton::Type::OctButtons) data.multi.octButtons = std::exchange(o.data.multi.octButtons, nullptr);
 		else if(o.type == Type::MultiButton) data.multi.quadButtons = std::exchange(o.data.multi.quadButtons, nullptr);
+		else if(o.type == Type::Derived) data.derived.derived = std::exchange(o.data.derived.derived, nullptr);
+		current = o.current;
+		changes = o.changes;
+		// A freshly created action isn't tracked, replacing a tracked action keeps its handle (which now reports the new action's state).
+		// Moving a tracked action takes its handle over, orphaning the handle this action had
+		if(o.states) {
+			if(states) states->owners[handle] = nullptr;
+			states = std::exchange(o.states, nullptr);
+			handle = std::exchange(o.handle, ActionStates::InvalidHandle);
+			states->owners[handle] = this;
+		}
+		if(states) states->Record(handle, current);
+		// Coroutines waiting on either action keep waiting on this one (so rebinding an action doesn't abandon them)
+		if(o.waiters) {
+			ActionAwaiter* tail = o.waiters;
+			for(auto* waiter = o.waiters; waiter; waiter = waiter->next) {
+				waiter->owner = this;
+				tail = waiter;
+			}
+			tail->next = waiters;
+			if(waiters) waiters->previous = tail;
+			waiters = std::exchange(o.waiters, nullptr);
+		}
+		// Both contexts lose an action (the moved from one is left without bindings)
+		BumpGeneration();
+		o.BumpGeneration();
 		return *this;
 	}
 
-	void Action::PumpButton(std::string_view name) {
-		assert(data.button.buttons);
-		uint8_t state = Button::IsSetPressed(*data.button.buttons);
-		if (state != data.button.last_state) {
-			if(data.button.combo) {
-				if(bool comboState = state == data.button.buttons->size(), lastComboState = data.button.last_state == data.button.buttons->size(); comboState != lastComboState)
-					callback(name, {(float)comboState}, {(float)lastComboState});
-			} else callback(name, {(float)state}, {(float)data.button.last_state});
-			data.button.last_state = state;
+	bool Action::Rebind(Action& prototype) {
+		assert(type == prototype.type && "Actions can only be rebound to bindings of the same type");
+		if(type != prototype.type) return false;
+		switch(type) {
+		break; case Type::Button:
+			std::swap(data.button.buttons, prototype.data.button.buttons);
+			std::swap(data.button.combo, prototype.data.button.combo);
+			std::swap(data.button.exclusive, prototype.data.button.exclusive);
+		break; case Type::Axis:
+			std::swap(data.axis.type, prototype.data.axis.type);
+			std::swap(data.axis.gamepad, prototype.data.axis.gamepad);
+		break; case Type::Vector:
+			std::swap(data.vector.type, prototype.data.vector.type);
+			std::swap(data.vector.gamepad, prototype.data.vector.gamepad);
+			std::swap(data.vector.deadzone, prototype.data.vector.deadzone);
+			std::swap(data.vector.angularSlope, prototype.data.vector.angularSlope);
+		break; case Type::MultiButton:
+			// The type decides which pointer the union holds, so they are swapped together
+			std::swap(data.multi.type, prototype.data.multi.type);
+			std::swap(data.multi.quadButtons, prototype.data.multi.quadButtons);
+		break; case Type::Derived:
+			std::swap(data.derived.derived, prototype.data.derived.derived);
+		break; default: return false;
 		}
+		BumpGeneration();
+		return true;
 	}
 
-	void Action::PumpAxis(std::string_view name) {
-		float state = data.axis.last_state;
-		switch(data.axis.type) {
-		break; case Data::Axis::Type::Gamepad: {
-			float movement = GetGamepadAxisMovement(data.axis.gamepad.id, data.axis.gamepad.axis);
-			if(movement != 0) state += movement;
+	void Action::Wake(Vector2 previous, Vector2 state) {
+		for(auto* waiter = waiters; waiter; ) {
+			auto* next = waiter->next; // Firing unlinks the waiter
+			waiter->Update(previous, state);
+			waiter = next;
 		}
-		break; case Data::Axis::Type::MouseWheel: {
-			float movement = GetMouseWheelMove();
-			if(movement != 0) state += movement;
+	}
+
+	void Action::DetachWaiters() {
+		while(waiters) {
+			auto* waiter = waiters;
+			waiter->Unlink();
+			waiter->Cancel();
+			waiter->owner = nullptr;
 		}
-		break; default: assert(data.axis.type != Data::Axis::Type::Invalid);
+	}
+
+	ActionAwaiter::~ActionAwaiter() {
+		Unlink();
+		if(queued)
+			for(auto& waiting: input->ready)
+				if(waiting == this) waiting = nullptr;
+	}
+
+	bool ActionAwaiter::await_ready() const {
+		return condition == Condition::Reached && owner && Vector2Length(owner->current) >= value;
+	}
+
+#ifdef __cpp_impl_coroutine
+	void ActionAwaiter::await_suspend(std::coroutine_handle<> handle) {
+		this->handle = handle.address();
+		if(!owner) return;
+		next = owner->waiters;
+		if(next) next->previous = this;
+		previous = nullptr;
+		owner->waiters = this;
+		linked = true;
+		// A button which is already held starts counting now
+		if(condition == Condition::Held && (owner->current.x != 0 || owner->current.y != 0))
+			Schedule(&input->timers, input->now + value, {});
+	}
+#endif
+
+	void ActionAwaiter::Update(Vector2 previous, Vector2 state) {
+		bool was = previous.x != 0 || previous.y != 0, is = state.x != 0 || state.y != 0;
+		switch(condition) {
+		break; case Condition::Pressed:
+			if(is && !was) Fire(state);
+		break; case Condition::Released:
+			if(!is && was) Fire(state);
+		break; case Condition::Held:
+			if(is && !was) Schedule(&input->timers, input->now + value, {});
+			else if(!is) Cancel();
+		break; case Condition::Reached:
+			if(Vector2Length(state) >= value) Fire(state);
 		}
-		if (state != data.axis.last_state) {
-			callback(name, {state}, {state - data.axis.last_state});
-			data.axis.last_state = state;
+	}
+
+	void ActionAwaiter::Expire(std::string_view name, double time) {
+		if(owner) Fire(owner->current);
+	}
+
+	void ActionAwaiter::Fire(Vector2 state) {
+		Unlink();
+		Cancel();
+		result = state;
+		queued = true;
+		input->ready.push_back(this);
+	}
+
+	void ActionAwaiter::Unlink() {
+		if(!linked) return;
+		if(previous) previous->next = next;
+		else if(owner) owner->waiters = next;
+		if(next) next->previous = previous;
+		next = previous = nullptr;
+		linked = false;
+	}
+
+	void Action::Release(std::string_view name, bool notify) {
+		if(interaction) {
+			interaction->Cancel();
+			interaction->count = 0;
+			interaction->triggered = false;
 		}
+		if(repeat) repeat->Cancel();
+		if(processor) processor->state = {};
+
+		Vector2 previous = current;
+		switch(type) {
+		break; case Type::Button:
+			data.button.last_state = 0;
+		break; case Type::Axis:
+			// Only absolute readings rest at zero (accumulated sums are kept)
+			if(data.axis.mode != AnalogMode::Absolute) return;
+			previous = {data.axis.last_state, 0};
+			data.axis.last_state = 0;
+		break; case Type::Vector:
+			if(data.vector.mode != AnalogMode::Absolute || data.vector.type == Data::Vector::Type::MousePosition) return;
+			previous = data.vector.last_state;
+			data.vector.last_state = {0, 0};
+		break; case Type::MultiButton:
+			previous = data.multi.last_state;
+			data.multi.last_state = {0, 0};
+		break; case Type::Derived:
+			previous = data.derived.last_state;
+			data.derived.last_state = {0, 0};
+		break; default: return;
+		}
+		if(previous.x == 0 && previous.y == 0) return;
+
+		if(!notify) {
+			current = {0, 0};
+			changes++;
+			if(states) states->Record(handle, current);
+			if(waiters) Wake(previous, current);
+		} else if(type == Type::Button) Notify(name, {0}, {previous.x}); // Button callbacks receive the previous state instead of the change
+		else Notify(name, {0, 0}, Vector2Subtract({0, 0}, previous));
+	}
+
+	void Action::PumpButton(std::string_view name, const InputSnapshot& snapshot, TimerWheel* timers) {
+		assert(data.button.buttons);
+		uint8_t state = Button::IsSetPressed(*data.button.buttons, snapshot);
+		if (state != data.button.last_state) {
+			uint8_t triggered = ButtonTriggered(data.button, state), wasTriggered = ButtonTriggered(data.button, data.button.last_state);
+			if(interaction) {
+				if(bool pressed = triggered, wasPressed = wasTriggered; pressed != wasPressed)
+					interaction->Update(name, pressed, snapshot.time, timers);
+			} else if(triggered != wasTriggered)
+				EmitButton(name, {(float)triggered}, {(float)wasTriggered}, snapshot.time, timers);
+			data.button.last_state = state;
+		}
+		if(interaction) interaction->Poll(name, snapshot.time);
+		if(repeat) repeat->Poll(name, snapshot.time);
+	}
+
+	void Action::EmitButton(std::string_view name, Vector2 state, Vector2 previous, double time, TimerWheel* timers) {
+		Notify(name, state, previous);
+		if(!repeat) return;
+		if(state.x && !previous.x) repeat->Start(name, time, timers);
+		else if(!state.x) repeat->Cancel();
 	}
 
-	void Action::PumpVector(std::string_view name) {
-		Vector2 state = data.vector.last_state;
-		switch(data.vector.type) {
+	Vector2 Action::SampleAnalog(const InputSnapshot& snapshot) const {
+		if(type == Type::Axis) switch(data.axis.type) {
+		break; case Data::Axis::Type::Gamepad:
+			return {snapshot.GetGamepadAxisMovement(data.axis.gamepad.id, data.axis.gamepad.axis), 0};
+		break; case Data::Axis::Type::MouseWheel:
+			return {snapshot.GetMouseWheelMove(), 0};
+		break; default: assert(data.axis.type != Data::Axis::Type::Invalid);
+		}
+		else if(type == Type::Vector) switch(data.vector.type) {
 		break; case Data::Vector::Type::MouseWheel:
-			state = GetMouseWheelMoveV();
+			return snapshot.mouseWheel;
 		break; case Data::Vector::Type::MousePosition:
-			state = GetMousePosition();
-		// break; case Type::MouseDelta:
-		//     state = GetMouseDelta();
-		break; case Data::Vector::Type::GamepadAxes: {
-			state.x += GetGamepadAxisMovement(data.vector.gamepad.horizontal.id, data.vector.gamepad.horizontal.axis);
-			state.y += GetGamepadAxisMovement(data.vector.gamepad.vertical.id, data.vector.gamepad.vertical.axis);
-		}
+			return snapshot.mousePosition;
+		break; case Data::Vector::Type::MouseDelta:
+			return snapshot.mouseDelta;
+		break; case Data::Vector::Type::GamepadAxes:
+			return {
+				snapshot.GetGamepadAxisMovement(data.vector.gamepad.horizontal.id, data.vector.gamepad.horizontal.axis),
+				snapshot.GetGamepadAxisMovement(data.vector.gamepad.vertical.id, data.vector.gamepad.vertical.axis)
+			};
+		break; case Data::Vector::Type::GamepadDirection:
+			return QuantizeDirection({
+				snapshot.GetGamepadAxisMovement(data.vector.gamepad.horizontal.id, data.vector.gamepad.horizontal.axis),
+				snapshot.GetGamepadAxisMovement(data.vector.gamepad.vertical.id, data.vector.gamepad.vertical.axis)
+			}, data.vector.deadzone, data.vector.angularSlope);
 		break; default: assert(data.vector.type != Data::Vector::Type::Invalid);
 		}
-		if (!Vector2Equals(state, data.vector.last_state)) {
-			callback(name, state, Vector2Subtract(state, data.vector.last_state));
-			data.vector.last_state = state;
-		}
+		return {0, 0};
+	}
+
+	float Action::AccumulateAxis(const Data::Axis& axis, float& sum, float sample) {
+		if(axis.mode == AnalogMode::Accumulate)
+			return sum += sample;
+		if(axis.mode == AnalogMode::Clamped)
+			return sum = std::clamp(sum + sample, axis.min, axis.max);
+		return sample;
+	}
+
+	Vector2 Action::AccumulateVector(const Data::Vector& vector, Vector2& sum, Vector2 sample) {
+		if(vector.mode == AnalogMode::Accumulate)
+			return sum = Vector2Add(sum, sample);
+		if(vector.mode == AnalogMode::Clamped)
+			return sum = {
+				std::clamp(sum.x + sample.x, vector.min.x, vector.max.x),
+				std::clamp(sum.y + sample.y, vector.min.y, vector.max.y)
+			};
+		return sample;
+	}
+
+	bool Action::AxisChanged(const Data::Axis& axis, float state, float last) {
+		float delta = state - last;
+		return delta != 0 && (std::abs(delta) > axis.epsilon || state == 0);
+	}
+
+	bool Action::VectorChanged(const Data::Vector& vector, Vector2 state, Vector2 last) {
+		if (Vector2Equals(state, last)) return false;
+		return Vector2Length(Vector2Subtract(state, last)) > vector.epsilon || (state.x == 0 && state.y == 0);
+	}
+
+	void Action::CommitAxis(std::string_view name, float sample) {
+		if(data.axis.mode != AnalogMode::Absolute && sample != 0) accumulations++;
+		float state = AccumulateAxis(data.axis, data.axis.accumulated, sample);
+		if(!AxisChanged(data.axis, state, data.axis.last_state)) return;
+		Notify(name, {state}, {state - data.axis.last_state});
+		data.axis.last_state = state;
+	}
+
+	void Action::CommitVector(std::string_view name, Vector2 sample) {
+		if(data.vector.mode != AnalogMode::Absolute && (sample.x != 0 || sample.y != 0)) accumulations++;
+		Vector2 state = AccumulateVector(data.vector, data.vector.accumulated, sample);
+		if(!VectorChanged(data.vector, state, data.vector.last_state)) return;
+		Notify(name, state, Vector2Subtract(state, data.vector.last_state));
+		data.vector.last_state = state;
+	}
+
+	// Processes a single action (through a batch of one) when it is pumped outside of a BufferedInput
+	static void ProcessAnalogAlone(Action& action, std::string_view name, Vector2 sample, double time) {
+		thread_local AnalogBatch batch;
+		batch.Clear();
+		batch.Invalidate(); // Lone actions aren't tracked by anything which would notice their processor changing
+		batch.Add(action, name, sample, time);
+		batch.Process();
+		batch.Commit();
+	}
+
+	void Action::PumpAxis(std::string_view name, const InputSnapshot& snapshot) {
+		if(processor) return ProcessAnalogAlone(*this, name, SampleAnalog(snapshot), snapshot.time);
+		CommitAxis(name, SampleAnalog(snapshot).x);
+	}
+
+	void Action::PumpVector(std::string_view name, const InputSnapshot& snapshot) {
+		if(processor) return ProcessAnalogAlone(*this, name, SampleAnalog(snapshot), snapshot.time);
+		CommitVector(name, SampleAnalog(snapshot));
 	}
 
 	Action Action::gamepad_axes(GamepadAxis horizontal /*= GAMEPAD_AXIS_LEFT_X*/, GamepadAxis vertical /*= GAMEPAD_AXIS_LEFT_Y*/, int gamepadHorizontal /*= 0*/, int gamepadVertical /*= -1*/) {
@@ -108,46 +780,1384 @@ namespace raylib {
 		return out;
 	}
 
-	void Action::PumpMultiButton(std::string_view name) {
-		Vector2 state = data.multi.last_state;
-		{
-			auto type = data.multi.type;
-			std::array<uint8_t, 4> buttonState;
-			for(uint8_t i = 0; i < (type == Data::MultiButton::Type::QuadButtons ? 4 : 2); i++) {
-				buttonState[i] = Button::IsSetPressed(data.multi.quadButtons->directions[i]);
-				if(data.multi.quadButtons->normalize && buttonState[i] > 0)
-					buttonState[i] = 1;
-			}
-			if(type == Data::MultiButton::Type::QuadButtons)
-				state.x = buttonState[MultiButtonData<4>::Direction::Left] - buttonState[MultiButtonData<4>::Direction::Right];
-			state.y = buttonState[MultiButtonData<4>::Direction::Up] - buttonState[MultiButtonData<4>::Direction::Down];
+	Action Action::gamepad_direction(GamepadAxis horizontal /*= GAMEPAD_AXIS_LEFT_X*/, GamepadAxis vertical /*= GAMEPAD_AXIS_LEFT_Y*/, int gamepad /*= 0*/, float deadzone /*= .25*/, float angularDeadzone /*= PI / 8*/) {
+		Action out = gamepad_axes(horizontal, vertical, gamepad);
+		out.data.vector.type = Data::Vector::Type::GamepadDirection;
+		out.data.vector.deadzone = deadzone;
+		// The tangent is computed once here so that quantizing is only multiplies and comparisons
+		out.data.vector.angularSlope = std::tan(std::clamp<float>(angularDeadzone, 0, PI / 4));
+		return out;
+	}
+
+	Vector2 Action::QuantizeDirection(Vector2 stick, float deadzone, float angularSlope) {
+		if(stick.x * stick.x + stick.y * stick.y <= deadzone * deadzone)
+			return {0, 0};
+
+		float x = std::abs(stick.x), y = std::abs(stick.y);
+		Vector2 sign = {stick.x < 0 ? -1.f : 1.f, stick.y < 0 ? -1.f : 1.f};
+		if(y <= x * angularSlope) return {sign.x, 0};
+		if(x <= y * angularSlope) return {0, sign.y};
+		return sign;
+	}
 
-			if(type == Data::MultiButton::Type::ButtonPair)
-				state.x = state.y;
+	// Sums the pressed directions of a multi button action (the first 4 directions are cardinal and the rest diagonal)
+	template<size_t N>
+	static Vector2 SumDirections(const Action::MultiButtonData<N>& buttons, uint8_t count, const InputSnapshot& snapshot) {
+		using Direction = typename Action::MultiButtonData<N>::Direction;
+		std::array<uint8_t, 8> buttonState = {};
+		for(uint8_t i = 0; i < count; i++) {
+			buttonState[i] = Button::IsSetPressed(buttons.directions[i], snapshot);
+			if(buttons.normalize && buttonState[i] > 0)
+				buttonState[i] = 1;
 		}
+
+		float left = buttonState[Direction::Left] + buttonState[Direction::UpLeft] + buttonState[Direction::DownLeft];
+		float right = buttonState[Direction::Right] + buttonState[Direction::UpRight] + buttonState[Direction::DownRight];
+		float up = buttonState[Direction::Up] + buttonState[Direction::UpLeft] + buttonState[Direction::UpRight];
+		float down = buttonState[Direction::Down] + buttonState[Direction::DownLeft] + buttonState[Direction::DownRight];
+		Vector2 state = {left - right, up - down};
+		if(buttons.normalize)
+			state = {std::clamp(state.x, -1.f, 1.f), std::clamp(state.y, -1.f, 1.f)};
+		return state;
+	}
+
+	Vector2 Action::MultiButtonState(const Data::MultiButton& multi, const InputSnapshot& snapshot) {
+		Vector2 state = {0, 0};
+		switch(multi.type) {
+		break; case Data::MultiButton::Type::ButtonPair:
+			state = SumDirections(*multi.quadButtons, 2, snapshot);
+			state.x = state.y;
+		break; case Data::MultiButton::Type::QuadButtons:
+			state = SumDirections(*multi.quadButtons, 4, snapshot);
+		break; case Data::MultiButton::Type::OctButtons:
+			state = SumDirections(*multi.octButtons, 8, snapshot);
+		break; default:
+			assert(multi.type != Data::MultiButton::Type::Invalid);
+		}
+		return state;
+	}
+
+	void Action::PumpMultiButton(std::string_view name, const InputSnapshot& snapshot) {
+		Vector2 state = MultiButtonState(data.multi, snapshot);
 		if (!Vector2Equals(state, data.multi.last_state)) {
-			callback(name, state, Vector2Subtract(state, data.multi.last_state));
+			Notify(name, state, Vector2Subtract(state, data.multi.last_state));
 			data.multi.last_state = state;
 		}
 	}
 
 	void Action::PollEvents(std::string_view name) {
+		InputSnapshot snapshot;
+		PollEvents(name, snapshot.Capture(*this));
+	}
+
+	void Action::PollEvents(std::string_view name, const InputSnapshot& snapshot) {
+		PollEvents(name, snapshot, nullptr);
+	}
+
+	void Action::Dispatch(std::string_view name, Vector2 state, Vector2 delta) {
+		BUFFERED_RAYLIB_TRACE("Callback", name);
+		dispatched++;
+		if(eventLog) eventLog->push_back({0, name, state, delta});
+#ifdef BUFFERED_RAYLIB_LATENCY
+		// Measured up to the moment the callback is reached (so slow callbacks don't inflate the latency of the input)
+		latency.Record(GetTime() - eventTime);
+#endif
+#ifdef BUFFERED_RAYLIB_PROFILING
+		double start = Profiler::Now();
+		callback(name, state, delta);
+		double elapsed = Profiler::Now() - start;
+		Profiler::dispatched += elapsed;
+		stats.events++;
+		stats.callbackTime += elapsed;
+		stats.maxCallbackTime = std::max(stats.maxCallbackTime, elapsed);
+#else
+		callback(name, state, delta);
+#endif
+	}
+
+	double Action::EventTime(const InputSnapshot& snapshot) const {
+		// Only mouse motion and the wheel are timestamped by the hooks
+		bool hooked = (type == Type::Axis && data.axis.type == Data::Axis::Type::MouseWheel)
+			|| (type == Type::Vector && (data.vector.type == Data::Vector::Type::MouseWheel || data.vector.type == Data::Vector::Type::MousePosition || data.vector.type == Data::Vector::Type::MouseDelta));
+		return hooked ? snapshot.eventTime : snapshot.time;
+	}
+
+	void Action::PollEvents(std::string_view name, const InputSnapshot& snapshot, TimerWheel* timers) {
+#ifdef BUFFERED_RAYLIB_PROFILING
+		stats.evaluations++;
+#endif
+		SetEventTime(EventTime(snapshot));
 		switch(type){
-		break; case Action::Type::Button:
-			PumpButton(name);
-		break; case Action::Type::Axis:
-			PumpAxis(name);
-		break; case Action::Type::Vector:
-			PumpVector(name);
-		break; case Action::Type::MultiButton:
-			PumpMultiButton(name);
+		break; case Action::Type::Button: {
+			BUFFERED_RAYLIB_TRACE("PumpButton", name);
+			PumpButton(name, snapshot, timers);
+		}
+		break; case Action::Type::Axis: {
+			BUFFERED_RAYLIB_TRACE("PumpAxis", name);
+			PumpAxis(name, snapshot);
+		}
+		break; case Action::Type::Vector: {
+			BUFFERED_RAYLIB_TRACE("PumpVector", name);
+			PumpVector(name, snapshot);
+		}
+		break; case Action::Type::MultiButton: {
+			BUFFERED_RAYLIB_TRACE("PumpMultiButton", name);
+			PumpMultiButton(name, snapshot);
+		}
+		break; case Action::Type::Derived:
+			// Derived actions are computed from other actions by their context's DerivedGraph
 		break; default: assert(type != Action::Type::Invalid);
 		}
 	}
 
+	void AnalogBatch::Clear() {
+		for(auto* column: {&x, &y, &dt, &valueX, &valueY, &derivativeX, &derivativeY})
+			column->clear();
+		actions.clear(); names.clear(); times.clear(); primed.clear();
+		settled = true;
+	}
+
+	void AnalogBatch::Add(Action& action, std::string_view name, Vector2 sample, double time) {
+		assert(action.processor);
+#ifdef BUFFERED_RAYLIB_PROFILING
+		action.stats.evaluations++;
+#endif
+		auto& state = action.processor->state;
+		actions.push_back(&action);
+		names.push_back(name);
+		times.push_back(time);
+		x.push_back(sample.x);
+		y.push_back(sample.y);
+
+		primed.push_back(state.primed);
+		dt.push_back(state.primed ? std::max<float>(time - state.time, 1e-6f) : 1);
+		valueX.push_back(state.value.x);
+		valueY.push_back(state.value.y);
+		derivativeX.push_back(state.derivative.x);
+		derivativeY.push_back(state.derivative.y);
+	}
+
+	void AnalogBatch::Configure() {
+		BUFFERED_RAYLIB_TRACE("AnalogBatch::Configure");
+		for(auto* column: {&inner, &outer, &exponent, &scaleX, &scaleY, &minX, &minY, &maxX, &maxY, &smoothing, &minCutoff, &beta, &derivativeCutoff})
+			column->clear();
+		deadzone.clear(); filter.clear(); curved.clear();
+
+		for(uint32_t i = 0; i < actions.size(); i++) {
+			auto& p = *actions[i]->processor;
+			if(!p.curve.empty()) curved.push_back(i);
+			deadzone.push_back((int32_t)p.deadzone);
+			inner.push_back(p.deadzoneInner);
+			outer.push_back(p.deadzoneOuter);
+			exponent.push_back(p.curve.empty() ? std::max(p.exponent, AnalogProcessor::MinExponent) : 1); // Lookup tables replace the exponent
+			scaleX.push_back(p.invertX ? -p.scale.x : p.scale.x);
+			scaleY.push_back(p.invertY ? -p.scale.y : p.scale.y);
+			minX.push_back(p.min.x);
+			minY.push_back(p.min.y);
+			maxX.push_back(p.max.x);
+			maxY.push_back(p.max.y);
+
+			filter.push_back((int32_t)p.filter);
+			smoothing.push_back(p.smoothing);
+			minCutoff.push_back(p.minCutoff);
+			beta.push_back(p.beta);
+			derivativeCutoff.push_back(p.derivativeCutoff);
+		}
+		configured = actions;
+		stale = false;
+	}
+
+	// The processing kernels below are written as branchless loops over raw arrays so that compilers can vectorize them
+	// NOTE: every division is performed unconditionally (with a guarded denominator) since compilers won't speculate a division that might trap
+
+	static void DeadzoneKernel(size_t n, float* __restrict x, float* __restrict y, const int32_t* __restrict type, const float* __restrict inner, const float* __restrict outer) {
+		for(size_t i = 0; i < n; i++) {
+			float length = std::sqrt(x[i] * x[i] + y[i] * y[i]);
+			float axialX = std::abs(x[i]) < inner[i] ? 0.f : x[i];
+			float axialY = std::abs(y[i]) < inner[i] ? 0.f : y[i];
+			float radial = length < inner[i] ? 0.f : 1.f;
+			float scaled = std::min(std::max(length - inner[i], 0.f) / std::max(outer[i] - inner[i], 1e-6f), 1.f) / std::max(length, 1e-6f);
+
+			float factor = type[i] == (int32_t)AnalogProcessor::Deadzone::Radial ? radial
+				: type[i] == (int32_t)AnalogProcessor::Deadzone::ScaledRadial ? scaled : 1.f;
+			bool axial = type[i] == (int32_t)AnalogProcessor::Deadzone::Axial;
+			x[i] = (axial ? axialX : x[i]) * factor;
+			y[i] = (axial ? axialY : y[i]) * factor;
+		}
+	}
+
+	// NOTE: pow only vectorizes when the math library provides vector variants
+	static void CurveKernel(size_t n, float* __restrict v, const float* __restrict exponent) {
+		for(size_t i = 0; i < n; i++)
+			v[i] = std::copysign(std::pow(std::abs(v[i]), exponent[i]), v[i]);
+	}
+
+	static void ScaleClampKernel(size_t n, float* __restrict v, const float* __restrict scale, const float* __restrict min, const float* __restrict max) {
+		for(size_t i = 0; i < n; i++)
+			v[i] = std::min(std::max(v[i] * scale[i], min[i]), max[i]);
+	}
+
+	static void FilterKernel(size_t n, float* __restrict v, float* __restrict value, float* __restrict derivative, const int32_t* __restrict filter, const int32_t* __restrict primed,
+		const float* __restrict smoothing, const float* __restrict minCutoff, const float* __restrict beta, const float* __restrict derivativeCutoff, const float* __restrict dt
+	) {
+		constexpr float tau = 6.28318530718f;
+		// Smoothing factor of a first order low pass filter with the given cutoff frequency
+		auto alpha = [tau](float cutoff, float dt) { return 1 / (1 + 1 / std::max(tau * cutoff * dt, 1e-6f)); };
+
+		for(size_t i = 0; i < n; i++) {
+			float sample = v[i], previous = value[i], exponential = smoothing[i];
+			float speed = (sample - previous) / dt[i];
+			float estimatedSpeed = derivative[i] + alpha(derivativeCutoff[i], dt[i]) * (speed - derivative[i]);
+			float oneEuro = alpha(minCutoff[i] + beta[i] * std::abs(estimatedSpeed), dt[i]);
+
+			float a = filter[i] == (int32_t)AnalogProcessor::Filter::OneEuro ? oneEuro
+				: filter[i] == (int32_t)AnalogProcessor::Filter::Exponential ? exponential : 1.f;
+			a = primed[i] ? a : 1.f;
+			derivative[i] = primed[i] ? estimatedSpeed : 0.f;
+			v[i] = value[i] = previous + a * (sample - previous);
+		}
+	}
+
+	void AnalogBatch::Process() {
+		BUFFERED_RAYLIB_TRACE("AnalogBatch::Process");
+		if(stale || actions != configured)
+			Configure();
+		const size_t n = size();
+		DeadzoneKernel(n, x.data(), y.data(), deadzone.data(), inner.data(), outer.data());
+
+		CurveKernel(n, x.data(), exponent.data());
+		CurveKernel(n, y.data(), exponent.data());
+		for(uint32_t i: curved) { // Lookup tables can't be vectorized (they are gathers) so they are only applied to the actions which use them
+			auto& curve = actions[i]->processor->curve;
+			auto lookup = [&curve](float v) {
+				float position = std::min(std::abs(v), 1.f) * (curve.size() - 1);
+				size_t index = std::min<size_t>(position, curve.size() - 1);
+				size_t next = std::min(index + 1, curve.size() - 1);
+				return std::copysign(curve[index] + (curve[next] - curve[index]) * (position - index), v);
+			};
+			x[i] = lookup(x[i]);
+			y[i] = lookup(y[i]);
+		}
+
+		ScaleClampKernel(n, x.data(), scaleX.data(), minX.data(), maxX.data());
+		ScaleClampKernel(n, y.data(), scaleY.data(), minY.data(), maxY.data());
+
+		FilterKernel(n, x.data(), valueX.data(), derivativeX.data(), filter.data(), primed.data(), smoothing.data(), minCutoff.data(), beta.data(), derivativeCutoff.data(), dt.data());
+		FilterKernel(n, y.data(), valueY.data(), derivativeY.data(), filter.data(), primed.data(), smoothing.data(), minCutoff.data(), beta.data(), derivativeCutoff.data(), dt.data());
+	}
+
+	void AnalogBatch::Commit() {
+		BUFFERED_RAYLIB_TRACE("AnalogBatch::Commit");
+		for(size_t i = 0; i < size(); i++) {
+			auto& action = *actions[i];
+			settled &= action.processor->state.value.x == valueX[i] && action.processor->state.value.y == valueY[i];
+			action.processor->state = {{valueX[i], valueY[i]}, {derivativeX[i], derivativeY[i]}, times[i], true};
+			if(action.type == Action::Type::Axis) action.CommitAxis(names[i], x[i]);
+			else action.CommitVector(names[i], {x[i], y[i]});
+		}
+	}
+
 	void BufferedInput::PollEvents(bool whileUnfocused /*= false*/) {
-		if(!whileUnfocused && !IsWindowFocused()) return;
+		PollEvents(captured.Capture(), whileUnfocused);
+	}
+
+	bool BufferedInput::IsIdle(const InputSnapshot& snapshot) {
+		layout.clear();
+		layout.push_back(enabled ? actions.size() : -1);
+		layout.push_back(chords.dirty || derived.dirty);
+		layout.push_back(generation);
+		for(auto& [name, context]: contexts) {
+			layout.push_back(context.enabled ? context.actions.size() : -1);
+			layout.push_back(context.priority * 4 + context.consume * 2 + (context.chords.dirty || context.derived.dirty));
+			layout.push_back(context.generation);
+		}
+
+		bool idle = !invalidated && !changed && analog.Settled() && !HasPendingTimers()
+			&& gamepadMapping == lastMapping && layout == lastLayout
+			&& snapshot.IsIdleSince(last);
+		if(!idle) {
+			last = snapshot;
+			lastMapping = gamepadMapping;
+			std::swap(layout, lastLayout);
+			invalidated = false;
+		}
+		return idle;
+	}
+
+	void BufferedInput::PollEvents(const InputSnapshot& snapshot, bool whileUnfocused /*= false*/) {
+		PollActions(snapshot, whileUnfocused);
+		if(published) published->Publish(states, snapshot.time);
+	}
+
+	void BufferedInput::PollActions(const InputSnapshot& snapshot, bool whileUnfocused) {
+		states.BeginFrame();
+		ApplyBindings();
+		if(!whileUnfocused && !snapshot.focused) {
+			// Held actions are released once when focus is lost, so nothing stays stuck and regaining focus only reports what is held then
+			if(std::exchange(focused, false) && focusPolicy != FocusPolicy::Keep)
+				ReleaseAll(focusPolicy == FocusPolicy::Release);
+			return;
+		}
+		focused = true;
+		now = snapshot.time;
+		// Nothing can change on an idle frame, so every action is skipped
+		if((idle = skipIdleFrames && IsIdle(snapshot))) return;
+		BUFFERED_RAYLIB_TRACE("BufferedInput::PollEvents");
+		uint64_t dispatchedBefore = Action::dispatched, accumulationsBefore = Action::accumulations;
+#ifdef BUFFERED_RAYLIB_PROFILING
+		double start = Profiler::Now(), profiledBefore = Profiler::dispatched;
+#endif
+
+		// Apply the gamepad mapping once for the whole frame instead of once per button
+		const InputSnapshot* view = &snapshot;
+		if(gamepadMapping != InputSnapshot::IdentityMapping)
+			view = &remapped.RemapFrom(snapshot, gamepadMapping);
+
+		// Gather the enabled contexts (this input is itself the base context)
+		order.clear();
+		if(enabled) order.push_back(this);
+		for(auto& [name, context]: contexts)
+			if(context.enabled) order.push_back(&context);
+		std::stable_sort(order.begin(), order.end(), [](InputContext* a, InputContext* b) { return a->priority > b->priority; });
+
+		// Contexts disabled since the last poll release their held actions (and cancel their timers), so nothing stays held or keeps repeating while they are off
+		auto deactivate = [this](InputContext& context) {
+			if(context.active && !context.enabled) ReleaseContext(context, true);
+			context.active = context.enabled;
+		};
+		deactivate(*this);
+		for(auto& [name, context]: contexts)
+			deactivate(context);
+
+		// Timers which came due since the last poll expire before this poll's changes are applied
+		timers.Advance(view->time);
+
+		analog.Clear();
+		const InputSnapshot* contextView = view;
+		for(auto* context: order) {
+			PollContext(*context, *contextView);
+
+			// Hide the buttons this context consumed from every context after it
+			if(context->consume && context != order.back()) {
+				if(contextView != &working) contextView = &(working = *view);
+				for(auto& [name, action]: context->actions)
+					action.VisitButtons([this](const Button& button) { ReleaseButton(working, button); });
+			}
+		}
+
+		// Processed analog actions are updated together (after every other action)
+		analog.Process();
+		analog.Commit();
+
+		// Derived actions see the final state of every action they are computed from
+		for(auto* context: order)
+			if(!context->derived.nodes.empty())
+				context->derived.Evaluate();
+
+		sequences.Poll(*view);
+		// The states settle once a poll produces no events
+		// An accumulating action fed a steady reading below its epsilon dispatches nothing, but its sum still moves
+		changed = Action::dispatched != dispatchedBefore || Action::accumulations != accumulationsBefore;
+		ResumeReady();
+
+#ifdef BUFFERED_RAYLIB_PROFILING
+		pollStats.polls++;
+		pollStats.lastDispatchTime = Profiler::dispatched - profiledBefore;
+		pollStats.lastEvaluationTime = Profiler::Now() - start - pollStats.lastDispatchTime;
+		pollStats.dispatchTime += pollStats.lastDispatchTime;
+		pollStats.evaluationTime += pollStats.lastEvaluationTime;
+#endif
+	}
+
+	void BufferedInput::ReleaseContext(InputContext& context, bool notify) {
+		for(auto& [name, action]: context.actions)
+			action.Release(name, notify);
+		for(auto& chord: context.chords.chords)
+			chord.active = false;
+		context.chords.down.reset();
+	}
+
+	void BufferedInput::ReleaseAll(bool notify /*= true*/) {
+		BUFFERED_RAYLIB_TRACE("BufferedInput::ReleaseAll");
+		ReleaseContext(*this, notify);
+		for(auto& [name, context]: contexts)
+			ReleaseContext(context, notify);
+
+		sequences.Reset();
+		Invalidate();
+		ResumeReady();
+	}
+
+	void BindingMailbox::Publish(BindingTable table) {
+		Free(retired.exchange(nullptr, std::memory_order_acquire));
+		delete pending.exchange(new BindingTable(std::move(table)), std::memory_order_acq_rel); // A table which wasn't taken yet was never seen by the polling thread
+	}
+
+	void BindingMailbox::Retire(BindingTable* table) {
+		table->next = retired.load(std::memory_order_relaxed);
+		while(!retired.compare_exchange_weak(table->next, table, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	void BindingMailbox::Free(BindingTable* table) {
+		while(table)
+			delete std::exchange(table, table->next);
+	}
+
+	void BufferedInput::ApplyBindings() {
+		BindingTable* table = rebinds.Take();
+		if(!table) return;
+		BUFFERED_RAYLIB_TRACE("BufferedInput::ApplyBindings");
+		for(auto& entry: table->entries) {
+			InputContext* context = this;
+			if(!entry.context.empty()) {
+				auto found = contexts.find(entry.context);
+				if(found == contexts.end()) continue;
+				context = &found->second;
+			}
+			if(auto action = context->actions.find(entry.name); action != context->actions.end() && action->second.Rebind(entry.prototype))
+				context->InvalidateBindings();
+		}
+		Invalidate();
+		rebinds.Retire(table);
+	}
+
+	void BufferedInput::ResumeReady() {
+		// Resumed coroutines may queue more coroutines (or destroy queued ones) so the queue is walked by index
+		for(size_t i = 0; i < ready.size(); i++)
+			if(auto* awaiter = std::exchange(ready[i], nullptr)) {
+				awaiter->queued = false;
+#ifdef __cpp_impl_coroutine
+				std::coroutine_handle<>::from_address(awaiter->handle).resume();
+#endif
+			}
+		ready.clear();
+	}
+
+	void BufferedInput::ResetStats() {
+		pollStats = {};
+		for(auto& [name, action]: actions) action.ResetStats();
+		for(auto& [contextName, context]: contexts)
+			for(auto& [name, action]: context.actions) action.ResetStats();
+	}
+
+	void BufferedInput::ResetLatency() {
+		for(auto& [name, action]: actions) action.ResetLatency();
+		for(auto& [contextName, context]: contexts)
+			for(auto& [name, action]: context.actions) action.ResetLatency();
+	}
+
+	size_t LatencyHistogram::Index(uint32_t micros) {
+		if(micros < SubBuckets) return micros;
+		// Each power of two above the linear range is split into HalfSubBuckets buckets
+		size_t magnitude = std::bit_width(micros) - Precision;
+		return SubBuckets + (magnitude - 1) * HalfSubBuckets + ((micros >> magnitude) - HalfSubBuckets);
+	}
+
+	uint32_t LatencyHistogram::UpperBound(size_t index) {
+		if(index < SubBuckets) return index;
+		size_t magnitude = (index - SubBuckets) / HalfSubBuckets + 1;
+		uint64_t sub = (index - SubBuckets) % HalfSubBuckets + HalfSubBuckets;
+		return std::min<uint64_t>(((sub + 1) << magnitude) - 1, std::numeric_limits<uint32_t>::max());
+	}
+
+	void LatencyHistogram::Record(double seconds) {
+		uint32_t micros = std::clamp<double>(seconds * 1e6, 0, std::numeric_limits<uint32_t>::max());
+		counts[Index(micros)]++;
+		count++;
+		max = std::max(max, micros);
+	}
+
+	double LatencyHistogram::Percentile(double percentile) const {
+		if(!count) return 0;
+		uint64_t rank = std::max<uint64_t>(std::ceil(std::clamp(percentile, 0.0, 100.0) / 100 * count), 1);
+		uint64_t seen = 0;
+		for(size_t i = 0; i < Buckets; i++)
+			if((seen += counts[i]) >= rank)
+				return std::min(UpperBound(i), max) / 1e6;
+		return Max();
+	}
+
+	InputContext& InputContext::operator=(InputContext&& o) {
+		if(this == &o) return *this;
+		actions = std::move(o.actions);
+		priority = o.priority;
+		enabled = o.enabled;
+		consume = o.consume;
+		chords = std::move(o.chords);
+		derived = std::move(o.derived);
+		active = o.active;
+		// The actions now report their changes to this context (and the indices get rebuilt against them)
+		for(auto& [name, action]: actions)
+			action.generation = &generation;
+		generation++;
+		o.generation++;
+		return *this;
+	}
+
+	InputContext::~InputContext() {
+		// Destroying the actions would otherwise bump a generation which is already gone
 		for(auto& [name, action]: actions)
-			action.PollEvents(name);
+			action.generation = nullptr;
+	}
+
+	BufferedInput::~BufferedInput() {
+		for(Action* action: states.owners)
+			if(action) action->states = nullptr;
+	}
+
+	ActionStates::Handle BufferedInput::GetHandle(const std::string& name, const std::string& context /*= {}*/) {
+		Action& action = FindAction(name, context);
+		if(action.states != &states) {
+			action.states = &states;
+			action.handle = states.Add(action.current, &action);
+		}
+		return action.handle;
+	}
+
+	ActionStates::Handle ActionStates::Add(Vector2 initial, Action* owner /*= nullptr*/) {
+		Handle handle = size();
+		owners.push_back(owner);
+		valueX.push_back(initial.x);
+		valueY.push_back(initial.y);
+		deltaX.push_back(0);
+		deltaY.push_back(0);
+		if(handle % 64 == 0) {
+			down.push_back(0);
+			pressed.push_back(0);
+			released.push_back(0);
+		}
+		if(initial.x != 0 || initial.y != 0)
+			down[handle / 64] |= uint64_t(1) << (handle % 64);
+		return handle;
+	}
+
+	void ActionStates::BeginFrame() {
+		std::fill(deltaX.begin(), deltaX.end(), 0);
+		std::fill(deltaY.begin(), deltaY.end(), 0);
+		std::fill(pressed.begin(), pressed.end(), 0);
+		std::fill(released.begin(), released.end(), 0);
+	}
+
+	void ActionStates::Record(Handle handle, Vector2 state) {
+		if(handle >= size()) return;
+		deltaX[handle] += state.x - valueX[handle];
+		deltaY[handle] += state.y - valueY[handle];
+		valueX[handle] = state.x;
+		valueY[handle] = state.y;
+
+		uint64_t bit = uint64_t(1) << (handle % 64);
+		auto& word = down[handle / 64];
+		bool wasDown = word & bit, isDown = state.x != 0 || state.y != 0;
+		if(isDown && !wasDown) pressed[handle / 64] |= bit;
+		else if(!isDown && wasDown) released[handle / 64] |= bit;
+		word = isDown ? word | bit : word & ~bit;
+	}
+
+	// Packs a pair of floats into a single word (so they are published together)
+	static uint64_t PackPair(float x, float y) { return uint64_t(std::bit_cast<uint32_t>(x)) | uint64_t(std::bit_cast<uint32_t>(y)) << 32; }
+	static Vector2 UnpackPair(uint64_t word) { return {std::bit_cast<float>(uint32_t(word)), std::bit_cast<float>(uint32_t(word >> 32))}; }
+
+	PublishedStates::PublishedStates(size_t capacity /*= 256*/)
+		: capacity(capacity), words(std::make_unique<std::atomic<uint64_t>[]>(Header + capacity * 2 + (capacity + 63) / 64 * 3)) {}
+
+	void PublishedStates::Publish(const ActionStates& states, double time) {
+		size_t count = std::min(states.size(), capacity);
+		uint64_t seq = sequence.load(std::memory_order_relaxed);
+		sequence.store(seq + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release); // The sequence turns odd before any data changes
+
+		words[0].store(count, std::memory_order_relaxed);
+		words[1].store(std::bit_cast<uint64_t>(time), std::memory_order_relaxed);
+		for(size_t i = 0; i < count; i++) {
+			words[ValueWord(i)].store(PackPair(states.valueX[i], states.valueY[i]), std::memory_order_relaxed);
+			words[ValueWord(i) + 1].store(PackPair(states.deltaX[i], states.deltaY[i]), std::memory_order_relaxed);
+		}
+		for(size_t w = 0; w * 64 < count; w++) {
+			uint64_t mask = count - w * 64 >= 64 ? ~uint64_t(0) : (uint64_t(1) << (count - w * 64)) - 1; // Handles past the capacity are dropped
+			words[BitsWord(w * 64)].store(states.down[w] & mask, std::memory_order_relaxed);
+			words[BitsWord(w * 64) + 1].store(states.pressed[w] & mask, std::memory_order_relaxed);
+			words[BitsWord(w * 64) + 2].store(states.released[w] & mask, std::memory_order_relaxed);
+		}
+
+		sequence.store(seq + 2, std::memory_order_release);
+	}
+
+	bool PublishedStates::TryRead(ActionStates& out, double* time /*= nullptr*/) const {
+		uint64_t seq = sequence.load(std::memory_order_acquire);
+		if(seq & 1) return false;
+
+		size_t count = std::min<uint64_t>(words[0].load(std::memory_order_relaxed), capacity);
+		double published = std::bit_cast<double>(words[1].load(std::memory_order_relaxed));
+		for(auto* column: {&out.valueX, &out.valueY, &out.deltaX, &out.deltaY})
+			column->resize(count);
+		for(auto* column: {&out.down, &out.pressed, &out.released})
+			column->resize((count + 63) / 64);
+		for(size_t i = 0; i < count; i++) {
+			Vector2 value = UnpackPair(words[ValueWord(i)].load(std::memory_order_relaxed));
+			Vector2 delta = UnpackPair(words[ValueWord(i) + 1].load(std::memory_order_relaxed));
+			out.valueX[i] = value.x; out.valueY[i] = value.y;
+			out.deltaX[i] = delta.x; out.deltaY[i] = delta.y;
+		}
+		for(size_t w = 0; w < out.down.size(); w++) {
+			out.down[w] = words[BitsWord(w * 64)].load(std::memory_order_relaxed);
+			out.pressed[w] = words[BitsWord(w * 64) + 1].load(std::memory_order_relaxed);
+			out.released[w] = words[BitsWord(w * 64) + 2].load(std::memory_order_relaxed);
+		}
+
+		std::atomic_thread_fence(std::memory_order_acquire); // Every load above happens before the sequence is checked again
+		if(sequence.load(std::memory_order_relaxed) != seq) return false;
+		if(time) *time = published;
+		return true;
+	}
+
+	ActionStates::State PublishedStates::Get(ActionStates::Handle handle) const {
+		if(handle >= capacity) return {{0, 0}, {0, 0}, false, false, false};
+		uint64_t bit = uint64_t(1) << (handle % 64);
+		while(true) {
+			uint64_t seq = sequence.load(std::memory_order_acquire);
+			if(seq & 1) continue;
+
+			bool exists = handle < words[0].load(std::memory_order_relaxed);
+			Vector2 value = UnpackPair(words[ValueWord(handle)].load(std::memory_order_relaxed));
+			Vector2 delta = UnpackPair(words[ValueWord(handle) + 1].load(std::memory_order_relaxed));
+			uint64_t down = words[BitsWord(handle)].load(std::memory_order_relaxed);
+			uint64_t pressed = words[BitsWord(handle) + 1].load(std::memory_order_relaxed);
+			uint64_t released = words[BitsWord(handle) + 2].load(std::memory_order_relaxed);
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if(sequence.load(std::memory_order_relaxed) != seq) continue;
+			if(!exists) return {{0, 0}, {0, 0}, false, false, false};
+			return {value, delta, bool(down & bit), bool(pressed & bit), bool(released & bit)};
+		}
+	}
+
+	void BufferedInput::PollContext(InputContext& context, const InputSnapshot& snapshot) {
+		BUFFERED_RAYLIB_TRACE("BufferedInput::PollContext");
+		// Indices are rebuilt whenever an action is added, replaced, removed, or reconfigured
+		bool rebound = context.generation != context.polledGeneration || context.actions.size() != context.polledActions;
+		if(rebound) {
+			context.polledGeneration = context.generation;
+			context.polledActions = context.actions.size();
+			analog.Invalidate();
+		}
+		if(context.chords.dirty || rebound)
+			context.chords.Rebuild(context);
+		if(context.derived.dirty || rebound)
+			context.derived.Rebuild(context);
+
+		for(auto& [name, action]: context.actions) {
+			action.generation = &context.generation; // Actions added since the last poll start reporting their changes to the context
+			if(action.processor && (action.type == Action::Type::Axis || action.type == Action::Type::Vector)) {
+				action.SetEventTime(action.EventTime(snapshot));
+				analog.Add(action, name, action.SampleAnalog(snapshot), snapshot.time);
+			}
+			else if(action.type != Action::Type::Button || !action.data.button.exclusive)
+				action.PollEvents(name, snapshot, &timers);
+		}
+
+		if(!context.chords.chords.empty())
+			context.chords.Poll(snapshot, &timers);
+	}
+
+	// Invokes f with the index of every set bit, 64 bits at a time
+	template<size_t N, typename F>
+	static void ForEachSetBit(std::bitset<N> bits, F&& f) {
+		static const std::bitset<N> low(~0ull);
+		for(size_t base = 0; bits.any(); bits >>= 64, base += 64)
+			for(uint64_t word = (bits & low).to_ullong(); word; word &= word - 1)
+				f(base + std::countr_zero(word));
+	}
+
+	void ChordIndex::Rebuild(InputContext& context) {
+		buttons.clear();
+		bits.clear();
+		chords.clear();
+		down.reset();
+		dirty = false;
+
+		for(auto& [name, action]: context.actions) {
+			if(action.type != Action::Type::Button || !action.data.button.exclusive || !action.data.button.buttons || action.data.button.buttons->empty())
+				continue;
+
+			Chord chord{{}, action.data.button.buttons->size(), &action, name};
+			for(auto& button: *action.data.button.buttons) {
+				auto [bit, inserted] = bits.try_emplace(button, buttons.size());
+				if(inserted) buttons.push_back(button);
+				assert(bit->second < MaxButtons && "Too many distinct buttons are used by exclusive chords");
+				if(bit->second < MaxButtons) chord.mask.set(bit->second);
+			}
+			// A chord which was held while the index was rebuilt stays active so that it still gets released
+			chord.active = action.data.button.last_state;
+			chords.push_back(std::move(chord));
+		}
+
+		byButton.assign(std::min(buttons.size(), MaxButtons), {});
+		for(uint32_t c = 0; c < chords.size(); c++)
+			for(size_t bit = 0; bit < byButton.size(); bit++)
+				if(chords[c].mask[bit]) byButton[bit].push_back(c);
+		for(auto& list: byButton)
+			std::stable_sort(list.begin(), list.end(), [this](uint32_t a, uint32_t b) { return chords[a].size > chords[b].size; });
+
+		// Conflict index: every chord remembers which chords it shadows
+		for(uint32_t c = 0; c < chords.size(); c++) {
+			auto& chord = chords[c];
+			for(size_t bit = 0; bit < byButton.size(); bit++)
+				if(chord.mask[bit]) for(uint32_t other: byButton[bit])
+					if(chords[other].size < chord.size && (chords[other].mask & ~chord.mask).none())
+						chord.shadows.push_back(other);
+			std::sort(chord.shadows.begin(), chord.shadows.end());
+			chord.shadows.erase(std::unique(chord.shadows.begin(), chord.shadows.end()), chord.shadows.end());
+		}
+	}
+
+	void ChordIndex::Poll(const InputSnapshot& snapshot, TimerWheel* timers) {
+		BUFFERED_RAYLIB_TRACE("ChordIndex::Poll");
+		Mask now;
+		for(size_t bit = 0; bit < byButton.size(); bit++)
+			if(Button::IsPressed(buttons[bit], snapshot)) now.set(bit);
+		Mask pressed = now & ~down, released = down & ~now;
+		down = now;
+
+		// Only the chords containing a button which changed are visited
+		auto visit = [](Chord& chord) -> Chord& {
+#ifdef BUFFERED_RAYLIB_PROFILING
+			chord.action->stats.evaluations++;
+#endif
+			return chord;
+		};
+		// Chords feed their interaction (if any) just like PumpButton does
+		auto emit = [&](Chord& chord, bool pressed) {
+			chord.action->SetEventTime(snapshot.time);
+			if(chord.action->interaction) chord.action->interaction->Update(chord.name, pressed, snapshot.time, timers);
+			else chord.action->EmitButton(chord.name, {(float)pressed}, {(float)!pressed}, snapshot.time, timers);
+		};
+		auto release = [&](Chord& chord) {
+			chord.active = false;
+			chord.action->data.button.last_state = 0;
+			emit(chord, false);
+		};
+
+		ForEachSetBit(released, [&](size_t bit) {
+			for(uint32_t c: byButton[bit])
+				if(auto& chord = visit(chords[c]); chord.active) release(chord);
+		});
+
+		ForEachSetBit(pressed, [&](size_t bit) {
+			// The candidates are sorted most specific first, so the first fully pressed chord wins
+			for(uint32_t c: byButton[bit]) {
+				auto& chord = visit(chords[c]);
+				if((chord.mask & ~now).any()) continue;
+				if(!chord.active) {
+					for(uint32_t shadowed: chord.shadows)
+						if(chords[shadowed].active) release(chords[shadowed]);
+					chord.active = true;
+					chord.action->data.button.last_state = chord.size;
+					emit(chord, true);
+				}
+				break;
+			}
+		});
+	}
+
+	void DerivedGraph::Rebuild(InputContext& context) {
+		std::vector<Node> unsorted;
+		for(auto& [name, action]: context.actions) {
+			if(action.type != Action::Type::Derived || !action.data.derived.derived) continue;
+
+			Node node{&action, name};
+			for(auto& input: action.data.derived.derived->inputs)
+				if(auto found = context.actions.find(input); found != context.actions.end())
+					node.inputs.push_back(&found->second);
+				else assert(false && "Derived action's input doesn't exist in its context");
+			node.seen.assign(node.inputs.size(), 0);
+			node.states.resize(node.inputs.size());
+			// An action which keeps its place in the graph keeps its progress (so a rebuild doesn't replay every change)
+			if(auto old = std::find_if(nodes.begin(), nodes.end(), [&](const Node& n) { return n.action == &action; });
+				old != nodes.end() && old->inputs == node.inputs) {
+				node.seen = old->seen;
+				node.primed = old->primed;
+			}
+			unsorted.push_back(std::move(node));
+		}
+
+		// Depth first topological sort (derived actions are few, so quadratic lookups are fine)
+		nodes.clear();
+		std::vector<uint8_t> mark(unsorted.size(), 0); // 0 = unvisited, 1 = visiting, 2 = done
+		auto visit = [&](auto& self, size_t i) -> void {
+			if(mark[i] == 2) return;
+			assert(mark[i] != 1 && "Derived actions can't depend on themselves");
+			if(mark[i] == 1) return;
+			mark[i] = 1;
+			for(Action* input: unsorted[i].inputs)
+				for(size_t j = 0; j < unsorted.size(); j++)
+					if(unsorted[j].action == input) self(self, j);
+			mark[i] = 2;
+			nodes.push_back(std::move(unsorted[i]));
+		};
+		for(size_t i = 0; i < unsorted.size(); i++)
+			visit(visit, i);
+
+		dirty = false;
+	}
+
+	void DerivedGraph::Evaluate() {
+		BUFFERED_RAYLIB_TRACE("DerivedGraph::Evaluate");
+		for(auto& node: nodes) {
+			uint64_t changed = 0;
+			for(size_t i = 0; i < node.inputs.size(); i++)
+				if(node.inputs[i]->changes != node.seen[i]) {
+					changed |= uint64_t(1) << i;
+					node.seen[i] = node.inputs[i]->changes;
+				}
+			if(!changed && node.primed) continue;
+			node.primed = true;
+
+			auto& data = node.action->data.derived;
+			if(!data.derived->combine) continue;
+			for(size_t i = 0; i < node.inputs.size(); i++)
+				node.states[i] = node.inputs[i]->current;
+#ifdef BUFFERED_RAYLIB_LATENCY
+			// The change is timed from the most recent input event which caused it
+			double eventTime = -std::numeric_limits<double>::infinity();
+			for(size_t i = 0; i < node.inputs.size(); i++)
+				if((changed >> i) & 1) eventTime = std::max(eventTime, node.inputs[i]->eventTime);
+			if(changed) node.action->SetEventTime(eventTime);
+#endif
+#ifdef BUFFERED_RAYLIB_PROFILING
+			node.action->stats.evaluations++;
+#endif
+			Vector2 state = data.derived->combine(node.states, changed);
+			if(!Vector2Equals(state, data.last_state)) {
+				node.action->Notify(node.name, state, Vector2Subtract(state, data.last_state));
+				data.last_state = state;
+			}
+		}
+	}
+
+	ShortcutSequences::Callback& ShortcutSequences::Add(std::string name, const std::vector<ButtonSet>& sequence) {
+		assert(!sequence.empty());
+		uint32_t node = 0;
+		for(auto& set: sequence) {
+			Mask chord;
+			for(auto& button: set) {
+				auto [bit, inserted] = bits.try_emplace(button, buttons.size());
+				assert(bit->second < MaxButtons && "Too many distinct buttons are used by shortcut sequences");
+				if(bit->second >= MaxButtons) continue;
+				if(inserted) {
+					buttons.push_back(button);
+					uint16_t entry = bit->second + 1;
+					switch(button.type) {
+					break; case Button::Type::Keyboard:
+						if(button.keyboard >= 0 && button.keyboard < (int)InputSnapshot::MaxKeyboardKeys) keyBits[button.keyboard] = entry;
+					break; case Button::Type::Mouse:
+						if(button.mouse >= 0 && button.mouse < (int)InputSnapshot::MaxMouseButtons) mouseBits[button.mouse] = entry;
+					break; case Button::Type::Gamepad:
+						if(button.gamepad.id >= 0 && button.gamepad.id < (int)InputSnapshot::MaxGamepads && button.gamepad.button >= 0 && button.gamepad.button < (int)InputSnapshot::MaxGamepadButtons)
+							gamepadBits[button.gamepad.id][button.gamepad.button] = entry;
+					break; case Button::Type::Threshold:
+						if(button.threshold < InputSnapshot::MaxThresholds) thresholdBits[button.threshold] = entry;
+					break; default: break;
+					}
+				}
+				chord.set(bit->second);
+			}
+
+			auto [edge, inserted] = edges.try_emplace(Edge{node, chord}, nodes.size());
+			if(inserted) nodes.emplace_back();
+			nodes[node].leaf = false;
+			nodes[node].childUnion |= chord;
+			node = edge->second;
+		}
+
+		auto& leaf = nodes[node];
+		leaf.name = std::move(name);
+		leaf.terminal = true;
+		return leaf.callback;
+	}
+
+	void ShortcutSequences::Clear() {
+		nodes.clear();
+		nodes.emplace_back();
+		edges.clear();
+		buttons.clear();
+		bits.clear();
+		down.reset();
+		keys.reset();
+		mouseButtons.reset();
+		gamepadButtons = {};
+		thresholds.reset();
+		keyBits = {};
+		mouseBits = {};
+		gamepadBits = {};
+		thresholdBits = {};
+		current = 0;
+	}
+
+	void ShortcutSequences::Trigger(uint32_t node) {
+		BUFFERED_RAYLIB_TRACE("Callback", nodes[node].name);
+		current = 0;
+#ifdef BUFFERED_RAYLIB_PROFILING
+		double start = Profiler::Now();
+		nodes[node].callback(nodes[node].name);
+		Profiler::dispatched += Profiler::Now() - start;
+#else
+		nodes[node].callback(nodes[node].name);
+#endif
+	}
+
+	bool ShortcutSequences::Advance(const Mask& chord, double time) {
+		auto edge = edges.find(Edge{current, chord});
+		if(edge == edges.end()) return false;
+
+		current = edge->second;
+		lastTime = time;
+		// Sequences which aren't a prefix of another trigger immediately, the others wait to see if the longer sequence continues
+		if(nodes[current].leaf) Trigger(current);
+		return true;
+	}
+
+	void ShortcutSequences::Poll(const InputSnapshot& snapshot) {
+		BUFFERED_RAYLIB_TRACE("ShortcutSequences::Poll");
+		if(edges.empty()) return;
+
+		if(current && snapshot.time > Deadline()) {
+			if(nodes[current].terminal) Trigger(current);
+			else current = 0;
+		}
+
+		// Only inputs which changed since the last poll are visited, updating the held buttons in place
+		bool other = false;
+		Mask pressed;
+		auto update = [this, &pressed](uint16_t entry, bool isDown) {
+			if(!entry) return false;
+			down.set(entry - 1, isDown);
+			if(isDown) pressed.set(entry - 1);
+			return true;
+		};
+		// Keys and mouse buttons which aren't part of any sequence still break the current sequence
+		ForEachSetBit(snapshot.keys ^ keys, [&](size_t key) {
+			if(!update(keyBits[key], snapshot.keys[key])) other |= snapshot.keys[key];
+		});
+		ForEachSetBit(snapshot.mouseButtons ^ mouseButtons, [&](size_t button) {
+			if(!update(mouseBits[button], snapshot.mouseButtons[button])) other |= snapshot.mouseButtons[button];
+		});
+		for(size_t gamepad = 0; gamepad < InputSnapshot::MaxGamepads; gamepad++) {
+			uint32_t held = snapshot.gamepads[gamepad].buttons;
+			ForEachSetBit(std::bitset<InputSnapshot::MaxGamepadButtons>(held ^ gamepadButtons[gamepad]), [&](size_t button) {
+				update(gamepadBits[gamepad][button], (held >> button) & 1);
+			});
+			gamepadButtons[gamepad] = held;
+		}
+		ForEachSetBit(snapshot.thresholds ^ thresholds, [&](size_t threshold) {
+			update(thresholdBits[threshold], snapshot.thresholds[threshold]);
+		});
+		keys = snapshot.keys;
+		mouseButtons = snapshot.mouseButtons;
+		thresholds = snapshot.thresholds;
+		if(pressed.none() && !(other && current)) return;
+		// The chord entered is what was just pressed plus the held buttons which can continue from the node (ex. Ctrl held from Ctrl+K), so buttons still held from the previous chord (K when rolling over to Ctrl+C) are left out
+		auto chord = [&](uint32_t node) { return pressed | (down & nodes[node].childUnion); };
+		if(pressed.any() && Advance(chord(current), snapshot.time)) return;
+
+		// Buttons which are part of a chord continuing the sequence (ex. pressing Ctrl before K) don't break it
+		if(!other && (pressed & ~nodes[current].childUnion).none()) return;
+
+		// Anything else ends the sequence, triggering it if it was complete (but a prefix of a longer one) and possibly starting a new one
+		if(current) {
+			if(nodes[current].terminal) Trigger(current);
+			current = 0;
+			if(pressed.any()) Advance(chord(0), snapshot.time);
+		}
+	}
+
+	void TimerWheel::Schedule(const Timer& timer) {
+		// Timers which are already due go in the next slot to be visited
+		slots[std::max(Tick(timer.deadline), tick) % Slots].push_back(timer);
+		pending++;
+	}
+
+	TimerWheel::~TimerWheel() {
+		auto detach = [](Timer& timer) {
+			if(timer.owner && timer.owner->timer == timer.id) {
+				timer.owner->wheel = nullptr;
+				timer.owner->timer = 0;
+			}
+		};
+		for(auto& slot: slots)
+			for(auto& timer: slot) detach(timer);
+		for(auto& timer: due) detach(timer);
+	}
+
+	void TimerWheel::Cancel(uint64_t id, double deadline) {
+		// Timers which are being expired are already out of the slots, forgetting the owner stops Advance from invoking it
+		for(auto& timer: due)
+			if(timer.id == id) {
+				timer.owner = nullptr;
+				return;
+			}
+		auto& slot = slots[std::max(Tick(deadline), tick) % Slots];
+		if(auto timer = std::find_if(slot.begin(), slot.end(), [id](const Timer& t) { return t.id == id; }); timer != slot.end()) {
+			*timer = slot.back();
+			slot.pop_back();
+			pending--;
+		} else for(auto& slot: slots) // The timer was bucketed before the wheel turned past its deadline's slot
+			if(auto timer = std::find_if(slot.begin(), slot.end(), [id](const Timer& t) { return t.id == id; }); timer != slot.end()) {
+				*timer = slot.back();
+				slot.pop_back();
+				pending--;
+				return;
+			}
+	}
+
+	double TimerWheel::NextDeadline() const {
+		double next = std::numeric_limits<double>::infinity();
+		if(pending)
+			for(auto& slot: slots)
+				for(auto& timer: slot)
+					next = std::min(next, timer.deadline);
+		return next;
+	}
+
+	void TimerWheel::Advance(double time) {
+		size_t target = Tick(time);
+		if(pending) {
+			// Visit every slot between the last visited slot (which may hold timers due later in its tick) and the current one
+			size_t visits = std::min<size_t>(target - std::min(tick, target) + 1, Slots);
+			for(size_t i = 0; i < visits; i++) {
+				auto& slot = slots[(tick + i) % Slots];
+				for(size_t j = 0; j < slot.size(); )
+					if(slot[j].deadline <= time) {
+						due.push_back(slot[j]);
+						slot[j] = slot.back();
+						slot.pop_back();
+					} else j++;
+			}
+			pending -= due.size();
+		}
+		tick = std::max(tick, target);
+
+		std::sort(due.begin(), due.end(), [](const Timer& a, const Timer& b) { return a.deadline < b.deadline; });
+		for(auto& timer: due)
+			if(timer.owner && timer.owner->timer == timer.id) {
+				timer.owner->timer = 0;
+				timer.owner->Expire(timer.name, time);
+			}
+		due.clear();
+	}
+
+	void TimedBehaviour::Schedule(TimerWheel* wheel, double deadline, std::string_view name) {
+		static std::atomic<uint64_t> nextID = 1; // Ids are never reused so a stale timer can never be mistaken for a newer one (atomic since inputs may be polled in parallel)
+		Cancel();
+		this->wheel = wheel;
+		this->deadline = deadline;
+		timer = nextID.fetch_add(1, std::memory_order_relaxed);
+		if(wheel) wheel->Schedule({deadline, timer, this, name});
+	}
+
+	void TimedBehaviour::Cancel() {
+		if(timer && wheel) wheel->Cancel(timer, deadline);
+		timer = 0;
+	}
+
+	void Interaction::Trigger(std::string_view name, bool pressed, double time, TimerWheel* wheel) {
+		triggered = pressed;
+		if(owner) owner->EmitButton(name, {(float)pressed}, {(float)!pressed}, time, wheel);
+	}
+
+	void Interaction::Update(std::string_view name, bool pressed, double time, TimerWheel* wheel) {
+		switch(type) {
+		break; case Type::Tap:
+			if(pressed) pressTime = time;
+			else if(time - pressTime <= duration) {
+				Trigger(name, true, time, wheel);
+				Trigger(name, false, time, wheel);
+			}
+		break; case Type::Hold:
+			if(pressed) Schedule(wheel, time + duration, name);
+			else {
+				Cancel();
+				if(triggered) Trigger(name, false, time, wheel);
+			}
+		break; case Type::MultiTap:
+			if(pressed) {
+				if(count++ == 0) Schedule(wheel, time + duration, name); // The window starts with the first tap
+				if(count >= taps) {
+					Cancel();
+					count = 0;
+					Trigger(name, true, time, wheel);
+				}
+			} else if(triggered) Trigger(name, false, time, wheel);
+		break; case Type::ReleaseAfterHold:
+			if(pressed) pressTime = time;
+			else if(time - pressTime >= duration) {
+				Trigger(name, true, time, wheel);
+				Trigger(name, false, time, wheel);
+			}
+		}
+	}
+
+	void Interaction::Expire(std::string_view name, double time) {
+		if(owner) owner->SetEventTime(deadline);
+		switch(type) {
+		break; case Type::Hold:
+			Trigger(name, true, time, wheel);
+		break; case Type::MultiTap:
+			count = 0; // The window closed before enough taps
+		break; default: break;
+		}
+	}
+
+	void Repeat::Start(std::string_view name, double time, TimerWheel* wheel) {
+		count = 0;
+		Schedule(wheel, time + delay, name);
+	}
+
+	void Repeat::Expire(std::string_view name, double time) {
+		if(owner) owner->SetEventTime(deadline);
+		count++;
+		// Long frames skip the repeats they missed instead of emitting a burst
+		double next = deadline + 1 / rate;
+		Schedule(wheel, next > time ? next : time + 1 / rate, name);
+		if(owner) owner->Notify(name, {1, (float)count}, {1, (float)count - 1});
+	}
+
+	InputPool::InputPool(size_t threads /*= std::thread::hardware_concurrency()*/) {
+		threads = std::max<size_t>(threads, 1);
+		ranges = std::make_unique<Range[]>(threads);
+		// The thread calling PollEvents is worker 0
+		for(size_t worker = 1; worker < threads; worker++)
+			workers.emplace_back([this, worker] {
+				uint64_t seen = 0;
+				while(true) {
+					{
+						std::unique_lock lock(mutex);
+						started.wait(lock, [&] { return stopping || jobCount != seen; });
+						if(stopping) return;
+						seen = jobCount;
+					}
+					Work(worker);
+					std::scoped_lock lock(mutex);
+					if(--active == 0) finished.notify_one();
+				}
+			});
+	}
+
+	InputPool::~InputPool() {
+		{
+			std::scoped_lock lock(mutex);
+			stopping = true;
+		}
+		started.notify_all();
+		for(auto& worker: workers)
+			worker.join();
+	}
+
+	static uint64_t PackRange(uint64_t begin, uint64_t end) { return begin | end << 32; }
+
+	bool InputPool::Pop(size_t worker, size_t& index) {
+		auto& bounds = ranges[worker].bounds;
+		uint64_t range = bounds.load(std::memory_order_acquire);
+		while(true) {
+			uint32_t begin = range, end = range >> 32;
+			if(begin >= end) return false;
+			if(bounds.compare_exchange_weak(range, PackRange(begin + 1, end), std::memory_order_acq_rel)) {
+				index = begin;
+				return true;
+			}
+		}
+	}
+
+	bool InputPool::Steal(size_t worker, size_t& index) {
+		for(size_t i = 1; i < Threads(); i++) {
+			auto& victim = ranges[(worker + i) % Threads()].bounds;
+			uint64_t range = victim.load(std::memory_order_acquire);
+			while(true) {
+				uint32_t begin = range, end = range >> 32;
+				if(begin >= end) break;
+				uint32_t middle = begin + (end - begin) / 2;
+				if(victim.compare_exchange_weak(range, PackRange(begin, middle), std::memory_order_acq_rel)) {
+					// This worker's range is empty, so nobody else modifies it (thieves skip empty ranges)
+					ranges[worker].bounds.store(PackRange(middle + 1, end), std::memory_order_release);
+					index = middle;
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	void InputPool::Work(size_t worker) {
+		BUFFERED_RAYLIB_TRACE("InputPool::Work");
+		for(size_t index; Pop(worker, index) || Steal(worker, index); )
+			try {
+				(*job)(index);
+			} catch(...) {
+				// The remaining indices still run, the first exception is rethrown by ForEach once every worker is done
+				std::scoped_lock lock(mutex);
+				if(!error) error = std::current_exception();
+			}
+	}
+
+	void InputPool::ForEach(size_t count, const std::function<void(size_t index)>& f) {
+		if(count == 0) return;
+		assert(count <= std::numeric_limits<uint32_t>::max());
+		for(size_t worker = 0; worker < Threads(); worker++)
+			ranges[worker].bounds.store(PackRange(count * worker / Threads(), count * (worker + 1) / Threads()), std::memory_order_relaxed);
+
+		{
+			std::scoped_lock lock(mutex);
+			job = &f;
+			active = workers.size();
+			jobCount++;
+		}
+		started.notify_all();
+		Work(0);
+
+		std::unique_lock lock(mutex);
+		finished.wait(lock, [this] { return active == 0; });
+		job = nullptr;
+		if(auto thrown = std::exchange(error, nullptr)) {
+			lock.unlock();
+			std::rethrow_exception(thrown);
+		}
+	}
+
+	void InputPool::PollEvents(std::span<BufferedInput* const> inputs, std::span<const InputSnapshot> snapshots, bool whileUnfocused /*= false*/) {
+		BUFFERED_RAYLIB_TRACE("InputPool::PollEvents");
+		assert(inputs.size() <= snapshots.size());
+		if(logs.size() < inputs.size()) logs.resize(inputs.size());
+		ForEach(inputs.size(), [&](size_t i) {
+			// Stops recording even if a callback throws (the worker's next job may not want its events recorded)
+			struct LogScope {
+				LogScope(std::vector<InputEvent>* log) { Action::eventLog = log; }
+				~LogScope() { Action::eventLog = nullptr; }
+			} scope(recordEvents ? &logs[i] : nullptr);
+			logs[i].clear();
+			inputs[i]->PollEvents(snapshots[i], whileUnfocused);
+		});
+
+		// Each input's events are already in order, so concatenating them in input order is deterministic
+		events.clear();
+		for(uint32_t i = 0; i < inputs.size(); i++)
+			for(auto& event: logs[i]) {
+				events.push_back(event);
+				events.back().input = i;
+			}
+	}
+
+	ReplayBindings::ReplayBindings(const InputContext& context) {
+		for(auto& [name, action]: context.actions) {
+			// Actions which depend on timers, filters, or other actions can't be evaluated from a stream's compact state
+			if(action.processor || action.interaction || action.repeat) continue;
+
+			Action copy{action.type, action.data};
+			switch(action.type) {
+			break; case Action::Type::Button:
+				if(!action.data.button.buttons) continue;
+				copy.data.button.buttons = new ButtonSet(*action.data.button.buttons);
+			break; case Action::Type::Axis:
+				// Analog data doesn't own anything, so it is copied as is (apart from the live sum, streams start from zero unless SetInitial says otherwise)
+				copy.data.axis.accumulated = 0;
+			break; case Action::Type::Vector:
+				copy.data.vector.accumulated = {0, 0};
+			break; case Action::Type::MultiButton:
+				if(action.data.multi.type == Action::Data::MultiButton::Type::OctButtons)
+					copy.data.multi.octButtons = new Action::MultiButtonData<8>(*action.data.multi.octButtons);
+				else copy.data.multi.quadButtons = new Action::MultiButtonData<4>(*action.data.multi.quadButtons);
+			break; default:
+				copy.type = Action::Type::Invalid; // Keeps the copy from freeing the original's data
+				continue;
+			}
+			names.push_back(name);
+			actions.push_back(std::move(copy));
+		}
+	}
+
+	ReplayBindings& ReplayBindings::SetInitial(size_t binding, Vector2 value) {
+		auto& action = actions.at(binding);
+		if(action.type == Action::Type::Axis) action.data.axis.accumulated = value.x;
+		else if(action.type == Action::Type::Vector) action.data.vector.accumulated = value;
+		return *this;
+	}
+
+	ReplayBatch::ReplayBatch(std::shared_ptr<const ReplayBindings> bindings, size_t streams)
+		: bindings(std::move(bindings)), streams(streams) {
+		last.resize(this->bindings->size() * streams);
+		accumulated.resize(last.size());
+		for(size_t stream = 0; stream < streams; stream++)
+			Reset(stream);
+	}
+
+	void ReplayBatch::Reset(size_t stream) {
+		streams[stream] = {};
+		for(size_t binding = 0; binding < bindings->size(); binding++) {
+			auto& action = bindings->actions[binding];
+			last[Slot(stream, binding)] = {0, 0};
+			accumulated[Slot(stream, binding)] = action.type == Action::Type::Axis ? Vector2{action.data.axis.accumulated, 0}
+				: action.type == Action::Type::Vector ? action.data.vector.accumulated : Vector2{0, 0};
+		}
+	}
+
+	Vector2 ReplayBatch::GetState(size_t stream, size_t binding) const {
+		auto& action = bindings->actions[binding];
+		Vector2 state = last[Slot(stream, binding)];
+		if(action.type == Action::Type::Button && action.data.button.combo)
+			return {float(state.x == action.data.button.buttons->size())};
+		return state;
+	}
+
+	void ReplayBatch::Emit(size_t stream, uint32_t binding, Vector2 state, Vector2 delta) {
+		auto& s = streams[stream];
+		auto mix = [](uint64_t hash, uint64_t value) { return hash ^ (value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2)); };
+		s.checksum = mix(mix(mix(s.checksum, s.frames), binding), PackPair(state.x, state.y));
+		s.events++;
+		if(recordEvents) events.push_back({(uint32_t)stream, binding, state, delta});
+	}
+
+	void ReplayBatch::Process(std::span<const InputSnapshot* const> frames) {
+		BUFFERED_RAYLIB_TRACE("ReplayBatch::Process");
+		assert(frames.size() <= streams.size());
+		events.clear();
+		for(size_t stream = 0; stream < frames.size(); stream++)
+			if(frames[stream]) streams[stream].frames++;
+
+		// Each action is evaluated for every stream before moving on, through the same state update rules as the Pump and Commit functions of Action
+		for(uint32_t binding = 0; binding < bindings->size(); binding++) {
+			auto& action = bindings->actions[binding];
+			for(size_t stream = 0; stream < frames.size(); stream++) {
+				if(!frames[stream]) continue;
+				auto& frame = *frames[stream];
+				auto& previous = last[Slot(stream, binding)];
+
+				switch(action.type) {
+				break; case Action::Type::Button: {
+					uint8_t state = Button::IsSetPressed(*action.data.button.buttons, frame), lastState = previous.x;
+					if(state == lastState) continue;
+					uint8_t triggered = Action::ButtonTriggered(action.data.button, state), wasTriggered = Action::ButtonTriggered(action.data.button, lastState);
+					if(triggered != wasTriggered) Emit(stream, binding, {(float)triggered}, {(float)wasTriggered});
+					previous.x = state;
+				}
+				break; case Action::Type::Axis: {
+					float state = Action::AccumulateAxis(action.data.axis, accumulated[Slot(stream, binding)].x, action.SampleAnalog(frame).x);
+					if(!Action::AxisChanged(action.data.axis, state, previous.x)) continue;
+					Emit(stream, binding, {state}, {state - previous.x});
+					previous.x = state;
+				}
+				break; case Action::Type::Vector: {
+					Vector2 state = Action::AccumulateVector(action.data.vector, accumulated[Slot(stream, binding)], action.SampleAnalog(frame));
+					if(!Action::VectorChanged(action.data.vector, state, previous)) continue;
+					Emit(stream, binding, state, Vector2Subtract(state, previous));
+					previous = state;
+				}
+				break; case Action::Type::MultiButton: {
+					Vector2 state = Action::MultiButtonState(action.data.multi, frame);
+					if(Vector2Equals(state, previous)) continue;
+					Emit(stream, binding, state, Vector2Subtract(state, previous));
+					previous = state;
+				}
+				break; default: break;
+				}
+			}
+		}
 	}
-}
\ No newline at end of file
+}
@@ -10,8 +10,31 @@
 #include <string>
 #include <string_view>
 #include <map>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <bitset>
+#include <cassert>
+#include <chrono>
+#include <cmath>
 #include <concepts>
+#include <condition_variable>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// The coroutine API (ActionAwaiter::await_suspend and InputTask) is only available when the compiler supports coroutines (older GCC needs -fcoroutines)
+#ifdef __cpp_impl_coroutine
+	#include <coroutine>
+#endif
 
 namespace raylib {
 
@@ -31,6 +54,178 @@ namespace raylib {
 		Delegate& operator=(callback_type callback) { set(callback); return *this; }
 	};
 
+	/**
+	 * @brief Optional hooks chained onto raylib's GLFW callbacks which capture input as individual events instead of once per frame.
+	 * 	While installed, snapshots use the hooked data (ex. summing every high resolution scroll event since that snapshot's last capture, raylib only keeps the last one).
+	 * @note Only available on desktop when the library is built with BUFFERED_RAYLIB_GLFW_HOOKS, otherwise Install always fails.
+	 */
+	struct GLFWHooks {
+		/**
+		 * @brief Installs the hooks on raylib's window (must be called after InitWindow), raylib's own callbacks keep getting invoked.
+		 *
+		 * @param rawMouseMotion when true (and supported) unaccelerated mouse motion is requested from the OS while the cursor is disabled
+		 * @return True if the hooks are installed, false otherwise.
+		 */
+		static bool Install(bool rawMouseMotion = false);
+		// Restores raylib's callbacks
+		static void Uninstall();
+		static bool Installed();
+
+		/**
+		 * @brief Running totals of the hooked events (never reset).
+		 * 	Each snapshot remembers the totals as of its last capture and reports the difference, so reading them never takes events away from another snapshot (no matter how many are captured per frame).
+		 */
+		struct Totals {
+			double wheelX = 0, wheelY = 0;
+			double deltaX = 0, deltaY = 0;
+			double resetX = 0, resetY = 0; // deltaX and deltaY as of the last ResetMouseDelta
+			uint64_t events = 0; // Mouse motion and wheel events received
+			uint64_t resets = 0; // Calls to ResetMouseDelta
+		};
+		static constexpr size_t EventHistory = 256; // Number of event times which are remembered
+
+		// Returns the running totals (used by InputSnapshot::Capture)
+		static Totals GetTotals();
+		// Returns the time (GetTime) of an event by its index in the totals, or a negative number if it hasn't happened yet (events older than the last EventHistory report the oldest remembered time)
+		static double GetEventTime(uint64_t event);
+		// Discards the mouse motion snapshots haven't read yet and measures future motion from the current cursor position (call after warping the cursor with SetMousePosition)
+		static void ResetMouseDelta();
+	};
+
+	struct Action;
+
+	/**
+	 * @brief A copy of the state of every input device raylib exposes, captured once per frame.
+	 * 	A single snapshot can be shared by any number of BufferedInputs (ex. one per local player) so that raylib only gets queried once per frame.
+	 */
+	struct InputSnapshot {
+		// raylib doesn't expose its internal limits, these are large enough to hold everything raylib 4.5 reports
+		static constexpr size_t MaxKeyboardKeys = 512;
+		static constexpr size_t MaxMouseButtons = 8;
+		static constexpr size_t MaxGamepads = 4;
+		static constexpr size_t MaxGamepadButtons = 32;
+		static constexpr size_t MaxGamepadAxes = 8;
+
+		// Maps the gamepad ids actions are bound to (index) onto the physical gamepad ids raylib reports (value), negative values mark a disconnected gamepad
+		using GamepadMapping = std::array<int, MaxGamepads>;
+		static constexpr GamepadMapping IdentityMapping = {0, 1, 2, 3};
+
+		std::bitset<MaxKeyboardKeys> keys;
+		std::bitset<MaxMouseButtons> mouseButtons;
+		Vector2 mousePosition = {0, 0};
+		Vector2 mouseDelta = {0, 0}; // Mouse motion since the previous capture
+		Vector2 mouseWheel = {0, 0};
+		/**
+		 * @brief The complete state of a single gamepad, read from raylib in one pass and packed so that evaluating a binding is a mask test
+		 */
+		struct GamepadState {
+			bool available = false;
+			uint8_t axisCount = 0;
+			uint32_t buttons = 0; // Bit n is set while GamepadButton n is down
+			std::array<float, MaxGamepadAxes> axes = {};
+
+			/**
+			 * @brief Refreshes this state from raylib (disconnected gamepads are skipped entirely)
+			 *
+			 * @param gamepad the physical id of the gamepad to read
+			 * @return GamepadState& this state (for chaining)
+			 */
+			GamepadState& Capture(int gamepad);
+
+			bool IsButtonDown(GamepadButton button) const { return button >= 0 && button < (int)MaxGamepadButtons && (buttons >> button) & 1; }
+			float GetAxisMovement(GamepadAxis axis) const { return axis >= 0 && axis < axisCount ? axes[axis] : 0; }
+
+			bool operator==(const GamepadState&) const = default;
+		};
+		static_assert(MaxGamepadButtons <= sizeof(GamepadState::buttons) * 8);
+
+		std::array<GamepadState, MaxGamepads> gamepads;
+
+		/**
+		 * @brief A virtual button which is pressed while a gamepad axis is pushed past a threshold (created with Button::axis_threshold or Button::axis_threshold_hysteresis).
+		 * 	The button presses once the axis reaches press and only releases once it falls back past release, a release above press watches the negative side of the axis.
+		 */
+		struct AxisThreshold {
+			int gamepad;
+			GamepadAxis axis;
+			float press;
+			float release;
+
+			bool operator==(const AxisThreshold&) const = default;
+			// Evaluates the threshold against a reading (wasDown provides the hysteresis)
+			bool Evaluate(float value, bool wasDown) const { return release > press ? (wasDown ? value < release : value <= press) : (wasDown ? value > release : value >= press); }
+		};
+		static constexpr size_t MaxThresholds = 64;
+		std::bitset<MaxThresholds> thresholds; // Bit n is set while registered threshold n is pressed
+
+		bool focused = true;
+		double time = 0; // Value of GetTime() when the snapshot was captured
+		double eventTime = 0; // Value of GetTime() when GLFWHooks received the first mouse motion or wheel event since the previous capture (the same as time without hooks or events)
+
+		/**
+		 * @brief Refreshes this snapshot with the current state of all of raylib's input devices.
+		 *
+		 * @return InputSnapshot& this snapshot (for chaining)
+		 */
+		InputSnapshot& Capture();
+		/**
+		 * @brief Refreshes only the parts of this snapshot which a single action reads (every other device keeps its old state).
+		 * 	Used by Action::PollEvents when an action is polled on its own, where capturing every key and gamepad would cost far more than the action.
+		 * @note Mouse readings come straight from raylib (GLFWHooks are only used by full captures)
+		 *
+		 * @param action the action whose inputs are read
+		 * @return InputSnapshot& this snapshot (for chaining)
+		 */
+		InputSnapshot& Capture(const Action& action);
+
+		/**
+		 * @brief Copies another snapshot into this one, shuffling the gamepads so that gamepad i in this snapshot holds physical gamepad mapping[i] from the source.
+		 * 	Used to give each local player their own view of the gamepads without requerying raylib.
+		 *
+		 * @param source the snapshot to copy from (must not be this snapshot)
+		 * @param mapping the logical to physical gamepad mapping
+		 * @return InputSnapshot& this snapshot (for chaining)
+		 */
+		InputSnapshot& RemapFrom(const InputSnapshot& source, const GamepadMapping& mapping);
+
+		/**
+		 * @brief Checks if nothing happened between two snapshots, every device reads the same and there is no relative motion (mouse delta or wheel).
+		 *
+		 * @param previous the earlier snapshot
+		 * @return True if the input is idle, false otherwise.
+		 */
+		bool IsIdleSince(const InputSnapshot& previous) const;
+
+		// Snapshot equivalents of the raylib query functions
+		bool IsKeyDown(KeyboardKey key) const { return key >= 0 && key < (int)MaxKeyboardKeys && keys[key]; }
+		bool IsMouseButtonDown(MouseButton button) const { return button >= 0 && button < (int)MaxMouseButtons && mouseButtons[button]; }
+		bool IsGamepadAvailable(int gamepad) const { return gamepad >= 0 && gamepad < (int)MaxGamepads && gamepads[gamepad].available; }
+		bool IsGamepadButtonDown(int gamepad, GamepadButton button) const { return gamepad >= 0 && gamepad < (int)MaxGamepads && gamepads[gamepad].IsButtonDown(button); }
+		float GetGamepadAxisMovement(int gamepad, GamepadAxis axis) const { return gamepad >= 0 && gamepad < (int)MaxGamepads ? gamepads[gamepad].GetAxisMovement(axis) : 0; }
+		float GetMouseWheelMove() const { return std::abs(mouseWheel.x) > std::abs(mouseWheel.y) ? mouseWheel.x : mouseWheel.y; }
+		bool IsThresholdDown(uint16_t threshold) const { return threshold < MaxThresholds && thresholds[threshold]; }
+
+		static constexpr uint16_t InvalidThreshold = std::numeric_limits<uint16_t>::max(); // Returned once every threshold is taken (never pressed)
+
+		/**
+		 * @brief Registers a threshold so that every snapshot evaluates it when captured (identical thresholds share a registration).
+		 * @note Safe to call from any thread
+		 *
+		 * @param threshold the threshold to register
+		 * @return uint16_t the index of the threshold's bit in thresholds (InvalidThreshold, with an error logged, once MaxThresholds distinct thresholds exist)
+		 */
+		static uint16_t RegisterThreshold(const AxisThreshold& threshold);
+		// Every threshold registered so far (registrations are never removed, so the span stays valid)
+		static std::span<const AxisThreshold> RegisteredThresholds();
+
+	protected:
+		// Evaluates every registered threshold against the gamepads, the current bits are the previous state used for hysteresis
+		void UpdateThresholds();
+
+		GLFWHooks::Totals hooked; // Hook totals as of this snapshot's last capture
+		bool hookedPrimed = false; // True once hooked has been read while the hooks were installed
+	};
+
 	/**
 	 * @brief Represents various input button types, including keyboard keys, mouse buttons, and gamepad buttons.
 	 */
@@ -40,7 +235,8 @@ namespace raylib {
 			Invalid = 0,
 			Keyboard,
 			Mouse,
-			Gamepad
+			Gamepad,
+			Threshold,
 		} type;
 
 		// Union to store different types of button configurations (raylib enums).
@@ -52,6 +248,7 @@ namespace raylib {
 				int id;
 				GamepadButton button;
 			} gamepad;
+			uint16_t threshold; // Index of an InputSnapshot::AxisThreshold
 		};
 
 		/**
@@ -67,6 +264,13 @@ namespace raylib {
 		 * @return True if the button is pressed, false otherwise.
 		 */
 		static bool IsPressed(const Button& button);
+		/**
+		 * @brief Checks if the specified button was pressed when the snapshot was captured.
+		 * @param button The button to check.
+		 * @param snapshot The device state to check against.
+		 * @return True if the button is pressed, false otherwise.
+		 */
+		static bool IsPressed(const Button& button, const InputSnapshot& snapshot);
 
 		/**
 		 * @brief Checks if a set of buttons is pressed.
@@ -74,6 +278,13 @@ namespace raylib {
 		 * @return The state of the buttons (number of buttons pressed) in the set.
 		 */
 		static uint8_t IsSetPressed(const std::set<Button>& buttons);
+		/**
+		 * @brief Checks if a set of buttons was pressed when the snapshot was captured.
+		 * @param buttons The set of buttons to check.
+		 * @param snapshot The device state to check against.
+		 * @return The state of the buttons (number of buttons pressed) in the set.
+		 */
+		static uint8_t IsSetPressed(const std::set<Button>& buttons, const InputSnapshot& snapshot);
 
 		// Static helper functions to create Button objects for different input types.
 		/**
@@ -107,7 +318,7 @@ namespace raylib {
 		 * @param gamrpad the gamepad the button is associated with (default 0)
 		 * @return Button 
 		 */
-		static Button pad(GamepadButton button, int gamepad = 0) { return { Type::Keyboard, {.gamepad = {gamepad, button}}}; }
+		static Button pad(GamepadButton button, int gamepad = 0) { return { Type::Gamepad, {.gamepad = {gamepad, button}}}; }
 		/**
 		 * @brief Creates a button associated with a gamepad buttion
 		 * 
@@ -126,11 +337,419 @@ namespace raylib {
 		 * @note same as joy
 		 */
 		static Button gamepad_button(GamepadButton button, int gamepad = 0) { return pad(button, gamepad); }
+
+		/**
+		 * @brief Creates a virtual button which is pressed while a gamepad axis is pushed past a threshold (ex. a trigger past 50%) and released once it falls back by .1
+		 * 	Multi-stage triggers are several thresholds on the same axis (ex. axis_threshold(GAMEPAD_AXIS_RIGHT_TRIGGER, -.5) and axis_threshold(GAMEPAD_AXIS_RIGHT_TRIGGER, .8) for a light and a full pull)
+		 *
+		 * @param axis the axis to watch
+		 * @param press the reading at which the button is pressed (default 0, a trigger pulled halfway)
+		 * @param gamepad the gamepad the axis is associated with (default 0)
+		 * @return Button
+		 * @note raylib reports triggers from -1 (released) to 1 (fully pulled), so a trigger pulled halfway reads 0
+		 */
+		static Button axis_threshold(GamepadAxis axis, float press = 0, int gamepad = 0) { return axis_threshold_hysteresis(axis, press, press - .1f, gamepad); }
+		// A floating point third argument is a release point, which would otherwise silently become the gamepad id (use axis_threshold_hysteresis)
+		template<std::floating_point Release>
+		static Button axis_threshold(GamepadAxis axis, float press, Release release, int gamepad = 0) = delete;
+		/**
+		 * @brief Creates a virtual button which is pressed while a gamepad axis is pushed past a threshold, with an explicit release point
+		 *
+		 * @param axis the axis to watch
+		 * @param press the reading at which the button is pressed
+		 * @param release the reading at which the button is released (a release above press watches the negative side of the axis, ex. a stick pushed left)
+		 * @param gamepad the gamepad the axis is associated with (default 0)
+		 * @return Button
+		 * @note The hysteresis is tracked by snapshots, Button::IsPressed without a snapshot only compares against press
+		 */
+		static Button axis_threshold_hysteresis(GamepadAxis axis, float press, float release, int gamepad = 0) { return { Type::Threshold, {.threshold = InputSnapshot::RegisterThreshold({gamepad, axis, press, release})}}; }
 	};
 
 	// Typedef for a set of buttons.
 	using ButtonSet = std::set<Button>;
 
+	/**
+	 * @brief Marks a button as released in a snapshot (used to hide buttons which have already been consumed).
+	 * @param snapshot The snapshot to modify.
+	 * @param button The button to release.
+	 */
+	void ReleaseButton(InputSnapshot& snapshot, const Button& button);
+
+	/**
+	 * @brief Chain of processing steps applied to the raw reading of an analog (axis or vector) action before it is reported.
+	 * 	The steps are always applied in the order: deadzone, response curve, invert, scale, clamp, filter; and every step defaults to doing nothing.
+	 * @note Axis actions are processed as a vector whose y component is always zero.
+	 * @note BufferedInput caches the configuration, call BufferedInput::Invalidate after modifying an action's processor in place (SetProcessor is noticed automatically)
+	 */
+	struct AnalogProcessor {
+		enum class Deadzone : int32_t {
+			None = 0,
+			Axial, // Each axis is zeroed independently while its magnitude is below deadzoneInner
+			Radial, // The whole vector is zeroed while its length is below deadzoneInner
+			ScaledRadial, // Like radial, but lengths between deadzoneInner and deadzoneOuter are rescaled to [0, 1]
+		};
+		enum class Filter : int32_t {
+			None = 0,
+			Exponential, // Exponential moving average weighted by smoothing
+			OneEuro, // One Euro filter (adaptive low pass which smooths slow movement while keeping fast movement responsive)
+		};
+
+		Deadzone deadzone = Deadzone::None;
+		float deadzoneInner = 0;
+		float deadzoneOuter = 1;
+
+		float exponent = 1; // Response curve, the magnitude of each axis is raised to this power
+		static constexpr float MinExponent = 1e-3f; // Smaller exponents are clamped to this (zero raised to a power at or below zero is infinite)
+		std::vector<float> curve = {}; // When not empty, a lookup table (evenly spaced over magnitudes [0, 1]) used as the response curve instead of the exponent
+
+		bool invertX = false, invertY = false;
+		Vector2 scale = {1, 1};
+		Vector2 min = {-std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity()};
+		Vector2 max = {std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity()};
+
+		Filter filter = Filter::None;
+		float smoothing = 1; // (Exponential) weight given to each new sample, 1 disables smoothing
+		float minCutoff = 1; // (OneEuro) cutoff frequency (Hz) used while the value is still
+		float beta = 0; // (OneEuro) how much the cutoff frequency grows as the value speeds up
+		float derivativeCutoff = 1; // (OneEuro) cutoff frequency (Hz) used to smooth the speed estimate
+
+		// Filter history, managed by the engine
+		struct State {
+			Vector2 value = {0, 0};
+			Vector2 derivative = {0, 0};
+			double time = 0;
+			bool primed = false;
+		} state = {};
+	};
+
+	struct Action;
+	struct TimedBehaviour;
+	struct ActionAwaiter;
+
+	/**
+	 * @brief Hashed timing wheel holding every pending timer (hold and multi-tap interactions, etc) of a BufferedInput.
+	 * 	Timers are bucketed by deadline, so advancing the wheel only visits the buckets which elapsed instead of every armed action.
+	 * @note Managed by BufferedInput, there usually isn't a need to use this directly!
+	 */
+	struct TimerWheel {
+		static constexpr size_t Slots = 256;
+		static constexpr double Resolution = 1.0 / 256; // Seconds covered by each slot (the wheel turns once a second)
+
+		struct Timer {
+			double deadline;
+			uint64_t id;
+			TimedBehaviour* owner;
+			std::string_view name;
+		};
+
+		TimerWheel() = default;
+		TimerWheel(const TimerWheel&) = delete;
+		TimerWheel& operator=(const TimerWheel&) = delete;
+		// Detaches every pending timer (so behaviours which outlive the wheel don't reach back into it)
+		~TimerWheel();
+
+		// Adds a timer to the wheel
+		void Schedule(const Timer& timer);
+		// Removes a timer from the wheel (including a timer which is due but hasn't been invoked yet)
+		void Cancel(uint64_t id, double deadline);
+		// Expires every timer whose deadline is at or before time
+		void Advance(double time);
+
+		size_t Pending() const { return pending; }
+		// Deadline of the earliest pending timer (infinity when nothing is pending)
+		double NextDeadline() const;
+
+	protected:
+		static size_t Tick(double time) { return time / Resolution; }
+
+		std::array<std::vector<Timer>, Slots> slots;
+		std::vector<Timer> due; // Scratch space (expired timers are invoked after they are removed so they can reschedule themselves)
+		size_t tick = 0;
+		size_t pending = 0;
+	};
+
+	/**
+	 * @brief Base of the timed behaviours which can be attached to button actions, owns at most one pending timer (which is cancelled when the behaviour is destroyed)
+	 */
+	struct TimedBehaviour {
+		TimedBehaviour() = default;
+		TimedBehaviour(const TimedBehaviour&) = delete;
+		TimedBehaviour& operator=(const TimedBehaviour&) = delete;
+		virtual ~TimedBehaviour() { Cancel(); }
+
+		// Arms the timer (replacing any pending timer), when no wheel is provided the timer is checked by Poll instead
+		void Schedule(TimerWheel* wheel, double deadline, std::string_view name);
+		// Disarms the timer
+		void Cancel();
+		// Expires the timer if it is due and isn't managed by a wheel
+		void Poll(std::string_view name, double time) {
+			if(timer && !wheel && deadline <= time) {
+				timer = 0;
+				Expire(name, time);
+			}
+		}
+		bool Armed() const { return timer; }
+
+		// Invoked when the timer expires
+		virtual void Expire(std::string_view name, double time) = 0;
+
+		Action* owner = nullptr; // Action this behaviour is attached to (kept up to date by Action)
+
+	protected:
+		friend struct TimerWheel;
+		TimerWheel* wheel = nullptr;
+		uint64_t timer = 0; // Id of the pending timer (0 when disarmed)
+		double deadline = 0;
+	};
+
+	/**
+	 * @brief Interaction which changes when a button action triggers (ex. only after being held for half a second).
+	 * 	The action's callback receives a press (state 1) when the interaction triggers and a release (state 0) once it ends.
+	 */
+	struct Interaction: public TimedBehaviour {
+		enum class Type : uint8_t {
+			Tap, // Triggers when the button is released within duration of being pressed
+			Hold, // Triggers once the button has been held for duration, releases with the button
+			MultiTap, // Triggers when the button is pressed taps times within duration, releases with the button
+			ReleaseAfterHold, // Triggers when the button is released after being held for at least duration
+		} type;
+		float duration; // Seconds
+		uint8_t taps = 2;
+
+		// State managed by the engine
+		double pressTime = 0;
+		uint8_t count = 0;
+		bool triggered = false;
+
+		Interaction(Type type, float duration, uint8_t taps = 2) : type(type), duration(duration), taps(taps) {}
+
+		// Feeds a change in the (raw) button state to the interaction
+		void Update(std::string_view name, bool pressed, double time, TimerWheel* wheel);
+		void Expire(std::string_view name, double time) override;
+
+	protected:
+		void Trigger(std::string_view name, bool pressed, double time, TimerWheel* wheel);
+	};
+
+	/**
+	 * @brief Key repeat (or autofire) which keeps emitting press events while a button action is triggered.
+	 * 	Repeated presses report a state of {1, n} (where n counts the repeats) and a previous state of {1, n - 1}, so callbacks can tell them apart from the initial press.
+	 */
+	struct Repeat: public TimedBehaviour {
+		float delay; // Seconds between the initial press and the first repeat
+		float rate; // Repeats per second after the first
+
+		// State managed by the engine
+		uint32_t count = 0;
+
+		Repeat(float delay, float rate) : delay(delay), rate(rate) {}
+
+		// Starts repeating (called when the action is triggered)
+		void Start(std::string_view name, double time, TimerWheel* wheel);
+		void Expire(std::string_view name, double time) override;
+	};
+
+	/**
+	 * @brief Profiling counters for a single action (only collected when compiled with BUFFERED_RAYLIB_PROFILING, otherwise always zero)
+	 */
+	struct ActionStats {
+		uint64_t evaluations = 0; // Times the action's state was evaluated
+		uint64_t events = 0; // Times the action's callback was invoked
+		double callbackTime = 0; // Seconds spent in the action's callback (in total)
+		double maxCallbackTime = 0; // Seconds spent in the longest single invocation of the action's callback
+	};
+
+	/**
+	 * @brief Profiling counters for BufferedInput::PollEvents (only collected when compiled with BUFFERED_RAYLIB_PROFILING, otherwise always zero)
+	 */
+	struct PollStats {
+		uint64_t polls = 0;
+		double evaluationTime = 0; // Seconds spent polling excluding callbacks (in total)
+		double dispatchTime = 0; // Seconds spent invoking callbacks while polling (in total)
+		double lastEvaluationTime = 0, lastDispatchTime = 0; // The same times for the most recent poll
+	};
+
+	/**
+	 * @brief Fixed size log-linear (HDR style) histogram of latencies, every bucket is within 6.25% of the values it holds.
+	 * 	Values are recorded in microseconds, from 0 up to about an hour (larger values land in the last bucket).
+	 */
+	struct LatencyHistogram {
+		static constexpr size_t Precision = 5; // Bits of each value which are kept exactly
+		static constexpr size_t SubBuckets = 1 << Precision, HalfSubBuckets = SubBuckets / 2;
+		static constexpr size_t Buckets = SubBuckets + (32 - Precision) * HalfSubBuckets; // Enough buckets for every 32 bit value
+
+		// Records a latency (in seconds, negative latencies are recorded as zero)
+		void Record(double seconds);
+		// Removes every recorded latency
+		void Reset() { *this = {}; }
+
+		uint64_t Count() const { return count; }
+		// Seconds which percentile (0 - 100) of the recorded latencies were at or below (the upper bound of the bucket holding it)
+		double Percentile(double percentile) const;
+		double P50() const { return Percentile(50); }
+		double P99() const { return Percentile(99); }
+		// The largest recorded latency in seconds (exact)
+		double Max() const { return max / 1e6; }
+
+	protected:
+		static size_t Index(uint32_t micros);
+		static uint32_t UpperBound(size_t index);
+
+		std::array<uint32_t, Buckets> counts = {};
+		uint64_t count = 0;
+		uint32_t max = 0; // Microseconds
+	};
+
+	/**
+	 * @brief Records spans of input processing (polls, pump loops, callbacks) and writes them to a Chrome trace JSON file (which also opens in Perfetto).
+	 * 	Every thread records into its own lock free ring buffer, Flush drains every buffer into the file; spans recorded while the buffer is full are dropped.
+	 * @note Only records when compiled with BUFFERED_RAYLIB_TRACING, otherwise Open always fails
+	 */
+	struct Tracer {
+		static constexpr size_t Capacity = 1 << 14; // Spans each thread can buffer between flushes
+
+		/**
+		 * @brief Starts tracing into a file (replacing its contents)
+		 *
+		 * @param path the file to write the trace to
+		 * @return bool true if the file was opened
+		 */
+		static bool Open(const char* path);
+		// Writes every buffered span to the file
+		static void Flush();
+		// Flushes and finishes the file
+		static void Close();
+		static bool IsOpen();
+
+		// Records a span (times are in nanoseconds from Now), the name is copied (and truncated)
+		static void Record(const char* category, std::string_view name, int64_t start, int64_t end);
+		static int64_t Now() { return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
+		/**
+		 * @brief Records a span covering its own lifetime
+		 */
+		struct Scope {
+			const char* category;
+			std::string_view name;
+			int64_t start = Now();
+
+			Scope(const char* category, std::string_view name = {}) : category(category), name(name) {}
+			~Scope() { Record(category, name, start, Now()); }
+		};
+	};
+
+#ifdef BUFFERED_RAYLIB_TRACING
+	#define BUFFERED_RAYLIB_TRACE_CONCAT_IMPL(a, b) a##b
+	#define BUFFERED_RAYLIB_TRACE_CONCAT(a, b) BUFFERED_RAYLIB_TRACE_CONCAT_IMPL(a, b)
+	// Records a span from this line until the end of the enclosing scope, arguments: category (string literal), optional name
+	#define BUFFERED_RAYLIB_TRACE(...) raylib::Tracer::Scope BUFFERED_RAYLIB_TRACE_CONCAT(bufferedRaylibTrace, __LINE__){__VA_ARGS__}
+#else
+	#define BUFFERED_RAYLIB_TRACE(...)
+#endif
+
+#ifdef BUFFERED_RAYLIB_PROFILING
+	/**
+	 * @brief Clock used by the profiling counters
+	 */
+	struct Profiler {
+		static double Now() { return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+		inline static thread_local double dispatched = 0; // Seconds spent invoking callbacks on this thread (polls measure how much this grows)
+	};
+#endif
+
+	/**
+	 * @brief Per frame state of the actions tracked by a BufferedInput, stored as parallel arrays indexed by action handle (for systems which read input in bulk instead of through callbacks).
+	 * 	The bitsets are packed 64 actions to a word so that whole groups of actions can be tested at once.
+	 */
+	struct ActionStates {
+		using Handle = uint32_t;
+		static constexpr Handle InvalidHandle = std::numeric_limits<Handle>::max();
+
+		/**
+		 * @brief The state of a single action, as returned by Get
+		 */
+		struct State {
+			Vector2 value; // The state of the action after the last poll
+			Vector2 delta; // How much the state changed during the last poll
+			bool down; // True while the state is non zero
+			bool pressed; // True if the state became non zero during the last poll
+			bool released; // True if the state became zero during the last poll
+		};
+
+		std::vector<float> valueX, valueY;
+		std::vector<float> deltaX, deltaY;
+		std::vector<uint64_t> down, pressed, released; // Bit (handle % 64) of word (handle / 64)
+		std::vector<Action*> owners; // Action each handle was issued for (null once it is destroyed or another action takes its handle over)
+
+		size_t size() const { return valueX.size(); }
+		bool IsDown(Handle handle) const { return handle < size() && (down[handle / 64] >> (handle % 64)) & 1; }
+		bool IsPressed(Handle handle) const { return handle < size() && (pressed[handle / 64] >> (handle % 64)) & 1; }
+		bool IsReleased(Handle handle) const { return handle < size() && (released[handle / 64] >> (handle % 64)) & 1; }
+		Vector2 GetValue(Handle handle) const { return handle < size() ? Vector2{valueX[handle], valueY[handle]} : Vector2{0, 0}; }
+		Vector2 GetDelta(Handle handle) const { return handle < size() ? Vector2{deltaX[handle], deltaY[handle]} : Vector2{0, 0}; }
+		State Get(Handle handle) const { return {GetValue(handle), GetDelta(handle), IsDown(handle), IsPressed(handle), IsReleased(handle)}; }
+
+		// Adds a slot for another action (starting in the provided state)
+		Handle Add(Vector2 initial, Action* owner = nullptr);
+		// Clears the deltas and the pressed and released bits (called at the start of every poll)
+		void BeginFrame();
+		// Records a change in the state of an action
+		void Record(Handle handle, Vector2 state);
+	};
+
+	/**
+	 * @brief The latest per frame action states, published by the polling thread through a seqlock so that any number of other threads (ex. render, audio) can read them without blocking it.
+	 * 	Readers never take a lock and never see a torn frame, they retry in the rare case that a poll is publishing while they read.
+	 * @note There must only be one publisher (see BufferedInput::published)
+	 */
+	struct PublishedStates {
+		/**
+		 * @brief Allocates space for the states of a fixed number of actions
+		 *
+		 * @param capacity the number of action handles which get published (handles past this are dropped)
+		 */
+		explicit PublishedStates(size_t capacity = 256);
+
+		// Publishes the states (called by the polling thread)
+		void Publish(const ActionStates& states, double time);
+
+		/**
+		 * @brief Copies the most recently published states
+		 *
+		 * @param out the states to fill in (its memory is reused between reads)
+		 * @param time when not null, filled in with the time of the snapshot the states were polled from
+		 * @return True if the copy is consistent, false if a poll published while copying (just try again)
+		 */
+		bool TryRead(ActionStates& out, double* time = nullptr) const;
+		// Copies the most recently published states (retrying until the copy is consistent)
+		void Read(ActionStates& out, double* time = nullptr) const { while(!TryRead(out, time)); }
+		// Reads the most recently published state of a single action (only touches that action's data)
+		ActionStates::State Get(ActionStates::Handle handle) const;
+		// Number of times the states have been published
+		uint64_t Frame() const { return sequence.load(std::memory_order_acquire) / 2; }
+
+		size_t Capacity() const { return capacity; }
+
+	protected:
+		static constexpr size_t Header = 2; // Count and time
+		size_t ValueWord(ActionStates::Handle handle) const { return Header + handle * 2; } // Packed value then packed delta
+		size_t BitsWord(ActionStates::Handle handle) const { return Header + capacity * 2 + handle / 64 * 3; } // Down, pressed, then released
+
+		size_t capacity;
+		std::unique_ptr<std::atomic<uint64_t>[]> words; // Every word is atomic so copying while the publisher writes is well defined (just possibly torn, which the sequence detects)
+		std::atomic<uint64_t> sequence = 0; // Odd while publishing
+	};
+
+	/**
+	 * @brief A single invocation of an action's callback, as recorded by InputPool
+	 */
+	struct InputEvent {
+		uint32_t input; // Index of the BufferedInput which produced the event
+		std::string_view name; // Name of the action (valid while the action exists)
+		Vector2 state;
+		Vector2 delta;
+	};
+
 	/**
 	 * @brief Represents various input action types, such as buttons, axes (controller trigger, mouse wheel), vectors (mouse, thumb stick), and multi-button combinations.
 	 */
@@ -141,7 +760,8 @@ namespace raylib {
 			Button,
 			Axis,
 			Vector,
-			MultiButton
+			MultiButton,
+			Derived
 		} type;
 
 		/**
@@ -152,6 +772,16 @@ namespace raylib {
 			GamepadAxis axis;
 		};
 
+		/**
+		 * @brief How the readings of axis and vector actions are turned into their state
+		 */
+		enum class AnalogMode : uint8_t {
+			Absolute = 0, // The state is the latest reading (ex. where the stick currently is)
+			Delta = Absolute, // For readings which are already relative (mouse wheel) the latest reading is how much it moved this frame
+			Accumulate, // The state is the sum of every reading (ex. how far the mouse wheel has scrolled in total), see ResetAccumulator
+			Clamped, // Like accumulate, but the sum is kept within a range (ex. a zoom level), see SetRange
+		};
+
 		/**
 		 * @brief Struct holding configuration data for multibutton actions
 		 *
@@ -168,6 +798,21 @@ namespace raylib {
 			bool normalize = true; // When true the maximum value returned for a given axis is 1, if false the value of each direction will be the sum of the buttons pressed pointing one direction minus the sum of the pressed buttons pointing the other direction
 		};
 
+		/**
+		 * @brief Function which computes the state of a derived action from the states of its inputs
+		 * 	changed has bit i set when input i changed since the derived action was last computed
+		 */
+		using Combine = std::function<Vector2(std::span<const Vector2> inputs, uint64_t changed)>;
+		static constexpr size_t MaxDerivedInputs = 64;
+
+		/**
+		 * @brief Struct holding configuration data for derived actions
+		 */
+		struct DerivedData {
+			std::vector<std::string> inputs; // Names of the actions (in the same context) this action is computed from
+			Combine combine;
+		};
+
 		// Union to store different types of action data.
 		// NOTE: It is recommended that you don't try to mess with these values yourself, instead use one of the factory functions below
 		// NOTE: Every inner type has a variable called last_state which holds the state as of the last time this action was pumped! 
@@ -177,6 +822,7 @@ namespace raylib {
 				ButtonSet* buttons;
 				bool combo = false; // When true all buttons in the set must be pressed for the action to trigger
 				uint8_t last_state = 0; // TODO: can we add a function to access the last state?
+				bool exclusive = false; // When true (and combo) only the most specific matching exclusive chord in the context triggers (ex. Ctrl+S suppresses S)
 			} button;
 
 			struct Axis {
@@ -188,6 +834,10 @@ namespace raylib {
 
 				Gamepad gamepad;
 				float last_state = 0;
+				AnalogMode mode = AnalogMode::Absolute;
+				float epsilon = 0; // The state must change by more than this before the callback is invoked (returning to exactly zero always invokes it)
+				float accumulated = 0;
+				float min = -std::numeric_limits<float>::infinity(), max = std::numeric_limits<float>::infinity(); // Range used by clamped mode
 			} axis;
 
 			struct Vector {
@@ -195,8 +845,9 @@ namespace raylib {
 					Invalid = 0,
 					MouseWheel,
 					MousePosition,
-					// MouseDelta,
+					MouseDelta,
 					GamepadAxes,
+					GamepadDirection, // Gamepad axes quantized into one of 8 directions
 				} type;
 
 				struct GamepadAxes{
@@ -204,6 +855,13 @@ namespace raylib {
 					Gamepad vertical;
 				} gamepad;
 				Vector2 last_state = { 0, 0 };
+				AnalogMode mode = AnalogMode::Absolute;
+				float epsilon = 0; // The length of the change in state must be greater than this before the callback is invoked (returning to exactly zero always invokes it)
+				Vector2 accumulated = { 0, 0 };
+				Vector2 min = { -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity() }; // Range used by clamped mode
+				Vector2 max = { std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity() };
+				float deadzone = 0; // Used by GamepadDirection: sticks closer to the center than this report no direction
+				float angularSlope = 0; // Used by GamepadDirection: tangent of the angular deadzone
 			} vector;
 
 			struct MultiButton {
@@ -211,23 +869,94 @@ namespace raylib {
 					Invalid = 0,
 					ButtonPair,
 					QuadButtons,
+					OctButtons,
 				} type;
 
-				MultiButtonData<4>* quadButtons;
+				union {
+					MultiButtonData<4>* quadButtons;
+					MultiButtonData<8>* octButtons; // Used by OctButtons
+				};
 				Vector2 last_state;
 			} multi;
+
+			struct Derived {
+				DerivedData* derived;
+				Vector2 last_state;
+			} derived;
 		} data;
 
 		// Callback invoked when the action is triggered
 		Delegate<void(const std::string_view name, Vector2 state, Vector2 delta)> callback;
 
+		// Optional processing (deadzones, response curves, smoothing, etc) applied to the raw readings of axis and vector actions
+		std::unique_ptr<AnalogProcessor> processor;
+		// Optional interaction (tap, hold, etc) which decides when a button action triggers
+		std::unique_ptr<Interaction> interaction;
+		// Optional key repeat (or autofire) which emits repeated presses while a button action is triggered
+		std::unique_ptr<Repeat> repeat;
+
+		// Generation of the context holding this action (pointed at by the context when it polls the action), incremented whenever this action is assigned, destroyed, or reconfigured through one of the setters below
+		uint64_t* generation = nullptr;
+
+		// State as of the last time the callback reported a change (what derived actions read)
+		Vector2 current = {0, 0};
+		uint32_t changes = 0; // Incremented every time the state changes
+		// Slot in a BufferedInput's ActionStates which mirrors this action's state (see BufferedInput::GetHandle)
+		ActionStates* states = nullptr;
+		ActionStates::Handle handle = ActionStates::InvalidHandle;
+		// Coroutines suspended until this action changes (see BufferedInput::Pressed and friends)
+		ActionAwaiter* waiters = nullptr;
+#ifdef BUFFERED_RAYLIB_PROFILING
+		ActionStats stats;
+#endif
+#ifdef BUFFERED_RAYLIB_LATENCY
+		LatencyHistogram latency;
+		double eventTime = 0; // Time of the input event behind the change currently being reported
+#endif
+
+		// Profiling counters for this action (always zero unless compiled with BUFFERED_RAYLIB_PROFILING)
+		const ActionStats& GetStats() const {
+#ifdef BUFFERED_RAYLIB_PROFILING
+			return stats;
+#else
+			static const ActionStats none;
+			return none;
+#endif
+		}
+		void ResetStats() {
+#ifdef BUFFERED_RAYLIB_PROFILING
+			stats = {};
+#endif
+		}
+
+		/**
+		 * @brief Latencies from the input events behind this action's changes to its callback being invoked (always empty unless compiled with BUFFERED_RAYLIB_LATENCY).
+		 * 	Events are timestamped when GLFWHooks receive them (mouse motion and wheel only), otherwise when the snapshot was captured; timer driven events (hold, repeat) are timed from their deadline.
+		 * @note Latencies are measured with GetTime(), so snapshots must be captured with raylib's clock
+		 */
+		const LatencyHistogram& GetLatency() const {
+#ifdef BUFFERED_RAYLIB_LATENCY
+			return latency;
+#else
+			static const LatencyHistogram none;
+			return none;
+#endif
+		}
+		void ResetLatency() {
+#ifdef BUFFERED_RAYLIB_LATENCY
+			latency.Reset();
+#endif
+		}
+
 		// Constructors and destructor for the Action class.
 		Action() : type(Type::Invalid), data({.button = {}}) {}
 		~Action() {
-			if(type == Type::Button && data.button.buttons) delete data.button.buttons;
-			else if(type == Type::MultiButton && data.multi.quadButtons) delete data.multi.quadButtons;
+			BumpGeneration(); // Indices holding this action must be rebuilt
+			if(states && states->owners[handle] == this) states->owners[handle] = nullptr;
+			DetachWaiters();
+			DeleteBindings();
 		}
-		Action(Type t, Data d = {.button = {nullptr, false, 0}}) : type(t), data(d) {}
+		Action(Type t, Data d = {.button = {nullptr, false, 0, false}}) : type(t), data(d) {}
 		Action(const Action&) = delete;
 		Action(Action&& o) : Action() { *this = std::move(o); }
 		Action& operator=(const Action&) = delete;
@@ -368,7 +1097,7 @@ namespace raylib {
 		 * @param combo wether all of the buttons in the set need to be pressed for a trigger (defaults to only a single button needing to be pressed)
 		 * @return Action
 		 */
-		static Action pad(GamepadButton b, int gamepad = 0, bool combo = false) { return button({ Button::Type::Keyboard, {.gamepad = {gamepad, b}}}, combo); }
+		static Action pad(GamepadButton b, int gamepad = 0, bool combo = false) { return button(Button::pad(b, gamepad), combo); }
 
 		/**
 		 * @brief Action that is invoked whenever the gamepad button is pressed.
@@ -408,6 +1137,21 @@ namespace raylib {
 		 */
 		static Action button_set(ButtonSet buttons = {}, bool combo = false) { return Action{Action::Type::Button, Action::Data{ .button = { new ButtonSet(buttons), combo }}}; }
 
+		/**
+		 * @brief Action that is invoked whenever all of the buttons in the chord are pressed, unless a more specific exclusive chord in the same context is also pressed.
+		 * 	ex. With chords {Ctrl, S} and {S}, pressing Ctrl+S only triggers the first.
+		 * Callback signature: [](const std::string_view name, uint8_t pressed, bool wasPressed) -> void;
+		 * @note Exclusive chords are resolved by a BufferedInput, when pumped on their own they behave like a combo button_set
+		 *
+		 * @param buttons the buttons which make up the chord
+		 * @return Action
+		 */
+		static Action chord(ButtonSet buttons) {
+			Action out = button_set(std::move(buttons), true);
+			out.data.button.exclusive = true;
+			return out;
+		}
+
 		/**
 		 * @brief Action that is invoked whenever the gamepad axis (usually triggers) is de/pressed.
 		 * Callback signature: [](const std::string_view name, float value, float delta) -> void
@@ -417,18 +1161,35 @@ namespace raylib {
 		 * @return Action
 		 */
 		static Action gamepad_axis(GamepadAxis axis = GAMEPAD_AXIS_LEFT_X, int gamepad = 0) {
-			return {Action::Type::Axis, {.axis = {Data::Axis::Type::Gamepad, {gamepad, axis}}}};
+			return {Action::Type::Axis, {.axis = {Data::Axis::Type::Gamepad, {gamepad, axis}, 0, AnalogMode::Absolute}}};
 		}
 
 		/**
 		 * @brief Action that is invoked whenever the mouse wheel is adjusted.
 		 * Callback signature: [](const std::string_view name, float value, float delta) -> void
 		 *
+		 * @param mode whether the value is how far the wheel moved this frame (Delta) or how far it has moved in total (Accumulate, default)
+		 * @return Action
+		 */
+		static Action mouse_wheel(AnalogMode mode = AnalogMode::Accumulate) {
+			return {Action::Type::Axis, {.axis = { Data::Axis::Type::MouseWheel, {}, 0, mode }}};
+		}
+
+		/**
+		 * @brief Action that accumulates how far the mouse wheel has moved, while keeping the total within a range (ex. for a zoom level).
+		 * Callback signature: [](const std::string_view name, float value, float delta) -> void
+		 *
+		 * @param min the smallest value the total can take
+		 * @param max the largest value the total can take
+		 * @param start the value the total starts at (default min)
 		 * @return Action
 		 */
-		static Action mouse_wheel() {
-			return {Action::Type::Axis, {.axis = { Data::Axis::Type::MouseWheel }}};
+		static Action mouse_wheel_clamped(float min, float max, float start) {
+			Action out = mouse_wheel(AnalogMode::Clamped);
+			out.SetRange(min, max).ResetAccumulator({start, 0});
+			return out;
 		}
+		static Action mouse_wheel_clamped(float min, float max) { return mouse_wheel_clamped(min, max, min); }
 
 		/**
 		 * @brief Action that combines button sets pointing in 2 opposing directions into a signed value which represents the direction of the currently pressed buttons.
@@ -465,10 +1226,11 @@ namespace raylib {
 		 * @brief Action that is invoked whenever the mouse wheel is adjusted (also supports wheels that can tilt side to side).
 		 * Callback signature: [](const std::string_view name, Vector2 dir, Vector2 delta) -> void
 		 *
+		 * @param mode whether the value is how far the wheel moved this frame (Delta, default) or how far it has moved in total (Accumulate)
 		 * @return Action
 		 */
-		static Action mouse_wheel_vector() {
-			return {Action::Type::Vector, {.vector = { Data::Vector::Type::MouseWheel }}};
+		static Action mouse_wheel_vector(AnalogMode mode = AnalogMode::Delta) {
+			return {Action::Type::Vector, {.vector = { Data::Vector::Type::MouseWheel, {}, {0, 0}, mode }}};
 		}
 
 		/**
@@ -481,6 +1243,18 @@ namespace raylib {
 			return {Action::Type::Vector, {.vector = { Data::Vector::Type::MousePosition }}};
 		}
 
+		/**
+		 * @brief Action that is invoked whenever the mouse moves, reporting how far it moved since the last poll (returns to zero once the mouse stops).
+		 * 	Unlike differentiating mouse_position this keeps working while the cursor is disabled,
+		 * 	and when GLFWHooks are installed every motion event between polls is summed (optionally using raw mouse motion).
+		 * Callback signature: [](const std::string_view name, Vector2 delta, Vector2 change) -> void
+		 *
+		 * @return Action
+		 */
+		static Action mouse_delta() {
+			return {Action::Type::Vector, {.vector = { Data::Vector::Type::MouseDelta }}};
+		}
+
 		/**
 		 * @brief Action that merges two seperate gamepad axis into a single vector.
 		 * Callback signature: [](const std::string_view name, Vector2 dir, Vector2 delta) -> void
@@ -493,6 +1267,30 @@ namespace raylib {
 		 */
 		static Action gamepad_axes(GamepadAxis horizontal = GAMEPAD_AXIS_LEFT_X, GamepadAxis vertical = GAMEPAD_AXIS_LEFT_Y, int gamepadHorizontal = 0, int gamepadVertical = -1);
 
+		/**
+		 * @brief Action that quantizes a pair of gamepad axes (usually a stick) into one of 8 digital directions, the components of the state are always -1, 0, or 1.
+		 * 	Useful for menu navigation and motion inputs since the callback is only invoked when the direction changes.
+		 * Callback signature: [](const std::string_view name, Vector2 dir, Vector2 delta) -> void
+		 *
+		 * @param horizontal the id of axis to listen for horizontal (x) data
+		 * @param vertical the id of axis to listen for vertical (y) data
+		 * @param gamepad id of the gamepad to listen to (default 0)
+		 * @param deadzone sticks closer to the center than this report no direction (default .25)
+		 * @param angularDeadzone radians around each cardinal direction which snap to it (default PI / 8, an even 8-way split), PI / 4 or more restricts the stick to 4 directions
+		 * @return Action
+		 */
+		static Action gamepad_direction(GamepadAxis horizontal = GAMEPAD_AXIS_LEFT_X, GamepadAxis vertical = GAMEPAD_AXIS_LEFT_Y, int gamepad = 0, float deadzone = .25, float angularDeadzone = PI / 8);
+
+		/**
+		 * @brief Quantizes a stick position into one of 8 directions.
+		 *
+		 * @param stick the position of the stick
+		 * @param deadzone sticks closer to the center than this report no direction
+		 * @param angularSlope tangent of the angle around each cardinal direction which snaps to it
+		 * @return Vector2 the direction, each component is -1, 0, or 1
+		 */
+		static Vector2 QuantizeDirection(Vector2 stick, float deadzone, float angularSlope);
+
 		/**
 		 * @brief Action that combines button sets pointing in 4 cardinal directions into a vector which represents the direction of the currently pressed buttons.
 		 * 	ex. If the up and left buttons are pressed, the resulting vector will be pointing upward and leftward.
@@ -515,12 +1313,86 @@ namespace raylib {
 		}
 
 		/**
-		 * @brief Action that combines button sets pointing in 4 cardinal directions into a vector which represents the direction of the currently pressed buttons.
-		 * 	ex. If the up and left buttons are pressed, the resulting vector will be pointing upward and leftward.
+		 * @brief Action that combines button sets pointing in 4 cardinal and 4 diagonal directions into a vector which represents the direction of the currently pressed buttons.
+		 * 	Diagonal sets count towards both of their axes (ex. an up left button is the same as pressing both up and left).
 		 * Callback signature: [](const std::string_view name, Vector2 dir, Vector2 delta) -> void
 		 *
-		 * @note This function is the same as quad, but the parameter order is changed to represent the common wasd convetion (and defaults are set to support it)
-		 *
+		 * @param up set of keys to represent up (+y) axis
+		 * @param down set of keys to represent down (-y) axis
+		 * @param left set of keys to represent left (-x) axis
+		 * @param right set of keys to represent right (+x) axis
+		 * @param upLeft set of keys to represent the up left diagonal
+		 * @param upRight set of keys to represent the up right diagonal
+		 * @param downLeft set of keys to represent the down left diagonal
+		 * @param downRight set of keys to represent the down right diagonal
+		 * @param normalized while true none of the vector's axis will ever excede 1.
+		 * @return Action
+		 */
+		static Action octo(ButtonSet up, ButtonSet down, ButtonSet left, ButtonSet right, ButtonSet upLeft, ButtonSet upRight, ButtonSet downLeft, ButtonSet downRight, bool normalized = true) {
+			Action out{Action::Type::MultiButton};
+			out.data.multi.type = Data::MultiButton::Type::OctButtons;
+			out.data.multi.octButtons = new MultiButtonData<8>{{ up, down, left, right, upLeft, upRight, downLeft, downRight }, {}, normalized};
+			return out;
+		}
+
+		/**
+		 * @brief Action whose state is computed from the states of other actions in the same context.
+		 * 	Derived actions are updated in dependency order at the end of each poll (after every other action), and only recomputed when one of their inputs changed.
+		 * Callback signature: [](const std::string_view name, Vector2 state, Vector2 delta) -> void
+		 *
+		 * @param inputs names of the actions this action is computed from (may include other derived actions, but not cycles)
+		 * @param combine function which computes the state from the states of the inputs
+		 * @return Action
+		 */
+		static Action derived(std::vector<std::string> inputs, Combine combine) {
+			assert(inputs.size() <= MaxDerivedInputs);
+			Action out{Action::Type::Derived};
+			out.data.derived = {new DerivedData{std::move(inputs), std::move(combine)}, {0, 0}};
+			return out;
+		}
+
+		/**
+		 * @brief Derived action which scales another action while a modifier is held (ex. move scaled by a sprint button).
+		 * Callback signature: [](const std::string_view name, Vector2 state, Vector2 delta) -> void
+		 *
+		 * @param value name of the action to scale
+		 * @param modifier name of the (button) action which enables the scaling
+		 * @param factor how much to scale the value by while the modifier is held
+		 * @return Action
+		 */
+		static Action modified(std::string value, std::string modifier, float factor) {
+			return derived({std::move(value), std::move(modifier)}, [factor](std::span<const Vector2> inputs, uint64_t) {
+				float scale = inputs[1].x ? factor : 1;
+				return Vector2{inputs[0].x * scale, inputs[0].y * scale};
+			});
+		}
+
+		/**
+		 * @brief Derived action which follows whichever of its inputs was used last (ex. aim with either a stick or the mouse).
+		 * 	An input is used when it changes to a non zero state, if several are used in the same poll the first one listed wins.
+		 * Callback signature: [](const std::string_view name, Vector2 state, Vector2 delta) -> void
+		 *
+		 * @param inputs names of the actions to choose between
+		 * @return Action
+		 */
+		static Action latest(std::vector<std::string> inputs) {
+			return derived(std::move(inputs), [active = size_t(0)](std::span<const Vector2> inputs, uint64_t changed) mutable {
+				for(size_t i = 0; i < inputs.size(); i++)
+					if((changed >> i) & 1 && (inputs[i].x != 0 || inputs[i].y != 0)) {
+						active = i;
+						break;
+					}
+				return inputs[active];
+			});
+		}
+
+		/**
+		 * @brief Action that combines button sets pointing in 4 cardinal directions into a vector which represents the direction of the currently pressed buttons.
+		 * 	ex. If the up and left buttons are pressed, the resulting vector will be pointing upward and leftward.
+		 * Callback signature: [](const std::string_view name, Vector2 dir, Vector2 delta) -> void
+		 *
+		 * @note This function is the same as quad, but the parameter order is changed to represent the common wasd convetion (and defaults are set to support it)
+		 *
 		 * @param up set of keys to represent up (+y) axis (default up arrow and w)
 		 * @param left set of keys to represent left (-x) axis (default left arrow and a)
 		 * @param down set of keys to represent down (-y) axis (default down arrow and s)
@@ -547,39 +1419,1010 @@ namespace raylib {
 		Action&& Move() { return std::move(*this); }
 		Action&& move() { return std::move(*this); }
 
+		/**
+		 * @brief Makes a button action trigger based on how it is pressed over time (tap, hold, multi-tap, or release after hold) instead of whenever it is pressed.
+		 *
+		 * @param interactionType the kind of interaction
+		 * @param duration seconds the interaction is timed against (see Interaction::Type)
+		 * @param taps number of taps needed for a multi-tap (default 2)
+		 * @return Action& this action (for chaining)
+		 */
+		Action& SetInteraction(Interaction::Type interactionType, float duration, uint8_t taps = 2) {
+			assert(type == Type::Button);
+			interaction = std::make_unique<Interaction>(interactionType, duration, taps);
+			interaction->owner = this;
+			BumpGeneration();
+			return *this;
+		}
+
+		/**
+		 * @brief Makes a button action emit repeated presses while it is held (ex. for text fields).
+		 *
+		 * @param delay seconds between the initial press and the first repeat
+		 * @param rate repeats per second after the first
+		 * @return Action& this action (for chaining)
+		 */
+		Action& SetRepeat(float delay, float rate) {
+			assert(type == Type::Button && rate > 0);
+			repeat = std::make_unique<Repeat>(delay, rate);
+			repeat->owner = this;
+			BumpGeneration();
+			return *this;
+		}
+		/**
+		 * @brief Makes a button action fire repeatedly at a steady rate while it is held (ex. turbo fire).
+		 *
+		 * @param rate presses per second
+		 * @return Action& this action (for chaining)
+		 */
+		Action& SetAutofire(float rate) { return SetRepeat(1 / rate, rate); }
+
+		/**
+		 * @brief Sets how readings are turned into the state of an axis or vector action.
+		 *
+		 * @param mode whether the state is the latest reading or the sum of every reading
+		 * @return Action& this action (for chaining)
+		 */
+		Action& SetMode(AnalogMode mode) {
+			assert(type == Type::Axis || type == Type::Vector);
+			if(type == Type::Axis) data.axis.mode = mode;
+			else data.vector.mode = mode;
+			BumpGeneration();
+			return *this;
+		}
+
+		/**
+		 * @brief Switches an axis action to clamped mode, accumulating its readings within the given range.
+		 *
+		 * @param min the smallest value the state can take
+		 * @param max the largest value the state can take
+		 * @return Action& this action (for chaining)
+		 */
+		Action& SetRange(float min, float max) {
+			assert(type == Type::Axis && min <= max);
+			data.axis.mode = AnalogMode::Clamped;
+			data.axis.min = min;
+			data.axis.max = max;
+			BumpGeneration();
+			return *this;
+		}
+		/**
+		 * @brief Switches a vector action to clamped mode, accumulating its readings within the given range (per component).
+		 *
+		 * @param min the smallest value each component of the state can take
+		 * @param max the largest value each component of the state can take
+		 * @return Action& this action (for chaining)
+		 */
+		Action& SetRange(Vector2 min, Vector2 max) {
+			assert(type == Type::Vector && min.x <= max.x && min.y <= max.y);
+			data.vector.mode = AnalogMode::Clamped;
+			data.vector.min = min;
+			data.vector.max = max;
+			BumpGeneration();
+			return *this;
+		}
+
+		/**
+		 * @brief Resets the sum of an accumulating (or clamped) axis or vector action, the new state is reported the next time the action is pumped.
+		 *
+		 * @param value the value to restart the sum from (default zero, the y component is ignored for axis actions)
+		 * @return Action& this action (for chaining)
+		 */
+		Action& ResetAccumulator(Vector2 value = {0, 0}) {
+			assert(type == Type::Axis || type == Type::Vector);
+			if(type == Type::Axis) data.axis.accumulated = value.x;
+			else data.vector.accumulated = value;
+			BumpGeneration();
+			return *this;
+		}
+
+		/**
+		 * @brief Sets how much the state of an axis or vector action needs to change before the callback is invoked.
+		 * 	Changes are measured from the last state reported to the callback, so noise which wiggles around a value never triggers it.
+		 *
+		 * @param epsilon the minimum change (length of the change for vectors)
+		 * @return Action& this action (for chaining)
+		 */
+		Action& SetEpsilon(float epsilon) {
+			assert(type == Type::Axis || type == Type::Vector);
+			if(type == Type::Axis) data.axis.epsilon = epsilon;
+			else data.vector.epsilon = epsilon;
+			BumpGeneration();
+			return *this;
+		}
+
+		/**
+		 * @brief Sets the processing chain applied to this action's raw readings before its state is updated.
+		 * @note Only axis and vector actions are processed.
+		 *
+		 * @param processor the processing to apply
+		 * @return Action& this action (for chaining)
+		 */
+		Action& SetProcessor(AnalogProcessor processor) {
+			assert(type == Type::Axis || type == Type::Vector);
+			this->processor = std::make_unique<AnalogProcessor>(std::move(processor));
+			this->processor->exponent = std::max(this->processor->exponent, AnalogProcessor::MinExponent);
+			BumpGeneration();
+			return *this;
+		}
+
+		/**
+		 * @brief Invokes a function with every button bound to this action
+		 *
+		 * @param f the function to invoke, signature: [](const Button& button) -> void
+		 */
+		template<typename F>
+		void VisitButtons(F&& f) const {
+			if(type == Type::Button && data.button.buttons)
+				for(auto& button: *data.button.buttons) f(button);
+			else if(type == Type::MultiButton && data.multi.type == Data::MultiButton::Type::OctButtons && data.multi.octButtons)
+				for(auto& set: data.multi.octButtons->directions)
+					for(auto& button: set) f(button);
+			else if(type == Type::MultiButton && data.multi.quadButtons)
+				for(auto& set: data.multi.quadButtons->directions)
+					for(auto& button: set) f(button);
+		}
+
 		/**
 		 * @brief Function which updates the state of the action and invokes the callback if a change occured.
 		 * @note Automatically called by BufferedInput so there usually isn't a need to manually call this function!
+		 * @note Only queries the inputs this action reads, prefer the snapshot overload when polling many actions
 		 * 
 		 * @param name the name of this action to pass through to the callback
 		 */
 		void PollEvents(std::string_view name);
+		/**
+		 * @brief Function which updates the state of the action from the provided snapshot and invokes the callback if a change occured.
+		 * 
+		 * @param name the name of this action to pass through to the callback
+		 * @param snapshot the device state to evaluate the action against
+		 */
+		void PollEvents(std::string_view name, const InputSnapshot& snapshot);
+		/**
+		 * @brief Function which updates the state of the action from the provided snapshot and invokes the callback if a change occured.
+		 * 
+		 * @param name the name of this action to pass through to the callback
+		 * @param snapshot the device state to evaluate the action against
+		 * @param timers the wheel timed interactions schedule their timers on (when null they are checked every poll instead)
+		 */
+		void PollEvents(std::string_view name, const InputSnapshot& snapshot, TimerWheel* timers);
 
 	protected:
 		friend struct BufferedInput;
+		friend struct AnalogBatch;
+		friend struct ChordIndex;
+		friend struct DerivedGraph;
+		friend struct Interaction;
+		friend struct Repeat;
+		friend struct ActionAwaiter;
+		friend struct InputPool;
+		friend struct ReplayBindings;
+		friend struct ReplayBatch;
+
+		// Frees the buttons (or derived inputs) owned by data
+		void DeleteBindings();
+		// Records a change in state and invokes the callback
+		void Notify(std::string_view name, Vector2 state, Vector2 delta) {
+			Vector2 previous = current;
+			current = state;
+			changes++;
+			if(states) states->Record(handle, state);
+			Dispatch(name, state, delta);
+			if(waiters) Wake(previous, state);
+		}
+		// Checks the conditions of the coroutines waiting on this action after its state changed
+		void Wake(Vector2 previous, Vector2 state);
+		// Abandons every waiting coroutine (they are never resumed)
+		void DetachWaiters();
+		// Tells the context holding this action that its bindings changed
+		void BumpGeneration() { if(generation) ++*generation; }
+		// Invokes the callback (timing it when profiling)
+		void Dispatch(std::string_view name, Vector2 state, Vector2 delta);
+		inline static thread_local uint64_t dispatched = 0; // Callbacks invoked on this thread (polls check if this grew to tell if anything changed)
+		inline static thread_local uint64_t accumulations = 0; // Non-zero readings added to accumulating or clamped actions on this thread (likewise)
+		inline static thread_local std::vector<InputEvent>* eventLog = nullptr; // When set, every callback invocation on this thread is also recorded here
+		// Marks when the input event behind the next dispatch happened (only tracked when measuring latency)
+		void SetEventTime([[maybe_unused]] double time) {
+#ifdef BUFFERED_RAYLIB_LATENCY
+			eventTime = time;
+#endif
+		}
+		// Time of the input event behind this action's state in a snapshot
+		double EventTime(const InputSnapshot& snapshot) const;
+
+		// Invokes the callback for a change in a button action's (triggered) state, starting or stopping key repeat
+		void EmitButton(std::string_view name, Vector2 state, Vector2 previous, double time, TimerWheel* timers);
+
+		// Swaps the bindings (buttons, axes, or derived inputs) of the prototype into this action while keeping this action's state and callbacks (returns false if their types differ)
+		bool Rebind(Action& prototype);
+
+		// Returns the action to its resting state (releasing buttons and centering sticks, but keeping positions and accumulated sums), invoking the callback only if notify is true
+		void Release(std::string_view name, bool notify);
 
 		// Functions which get called by BufferedInput to process actions
-		void PumpButton(std::string_view name);
-		void PumpAxis(std::string_view name);
-		void PumpVector(std::string_view name);
-		void PumpMultiButton(std::string_view name);
+		void PumpButton(std::string_view name, const InputSnapshot& snapshot, TimerWheel* timers);
+		void PumpAxis(std::string_view name, const InputSnapshot& snapshot);
+		void PumpVector(std::string_view name, const InputSnapshot& snapshot);
+		void PumpMultiButton(std::string_view name, const InputSnapshot& snapshot);
+
+		// Helpers which split analog pumping into reading the raw value and updating the state from a (possibly processed) reading
+		Vector2 SampleAnalog(const InputSnapshot& snapshot) const;
+		void CommitAxis(std::string_view name, float sample);
+		void CommitVector(std::string_view name, Vector2 sample);
+
+		// State update rules shared with ReplayBatch (which keeps the last state and sum of each stream outside of the action)
+		// Triggered state of a button action from how many of its buttons are pressed (a combo only triggers once every button is pressed)
+		static uint8_t ButtonTriggered(const Data::Button& button, uint8_t pressed) { return button.combo ? pressed == button.buttons->size() : pressed; }
+		// Applies the mode of an analog action to a reading (updating the accumulated sum) and returns the new state
+		static float AccumulateAxis(const Data::Axis& axis, float& sum, float sample);
+		static Vector2 AccumulateVector(const Data::Vector& vector, Vector2& sum, Vector2 sample);
+		// True if a change in the state of an analog action is reported (changes within epsilon are ignored unless the state returns to zero)
+		static bool AxisChanged(const Data::Axis& axis, float state, float last);
+		static bool VectorChanged(const Data::Vector& vector, Vector2 state, Vector2 last);
+		// State of a multi button action in a snapshot
+		static Vector2 MultiButtonState(const Data::MultiButton& multi, const InputSnapshot& snapshot);
 	};
 
+	/**
+	 * @brief Structure of arrays which gathers every processed analog action in a poll so that each processing step runs as a single branchless loop (which compilers vectorize).
+	 * @note Managed by BufferedInput, there usually isn't a need to use this directly!
+	 */
+	struct AnalogBatch {
+		// Removes all of the gathered actions (keeps the memory around for the next poll)
+		void Clear();
+		// Gathers the raw reading and the filter state of an action
+		void Add(Action& action, std::string_view name, Vector2 sample, double time);
+		// Runs every processing step over all of the gathered actions (regathering the processor configurations first if the actions or their bindings changed)
+		void Process();
+		// Writes the filter state back to each action and updates their states (invoking callbacks)
+		void Commit();
+
+		size_t size() const { return actions.size(); }
+		// True if no filter moved during the last commit (so the same readings would produce the same states)
+		bool Settled() const { return settled; }
+		// Forces the processor configurations to be regathered by the next Process (needed after modifying a processor in place)
+		void Invalidate() { stale = true; }
+
+	protected:
+		// Gathers the processor configuration of every action
+		void Configure();
+
+		bool settled = true;
+		// Gathered every poll
+		std::vector<Action*> actions;
+		std::vector<std::string_view> names;
+		std::vector<double> times;
+		std::vector<float> x, y;
+		std::vector<int32_t> primed;
+		std::vector<float> dt;
+		std::vector<float> valueX, valueY, derivativeX, derivativeY;
+
+		// Gathered by Configure, only when the processed actions or their bindings change
+		std::vector<Action*> configured; // The actions the configuration was gathered for (in order)
+		bool stale = true;
+		std::vector<int32_t> deadzone;
+		std::vector<float> inner, outer, exponent;
+		std::vector<uint32_t> curved; // Indices of the actions using a lookup table response curve
+		std::vector<float> scaleX, scaleY, minX, minY, maxX, maxY;
+		std::vector<int32_t> filter;
+		std::vector<float> smoothing, minCutoff, beta, derivativeCutoff;
+	};
+
+
+	struct InputContext;
 
 	/**
-	 * @brief InputManager which is responsible for a map of actions and updating their values
+	 * @brief Index over the exclusive chords in a context which resolves which chord a key press triggers.
+	 * 	Each button is assigned a bit, and every button lists the chords containing it from most to least specific;
+	 * 	so a press only tests the chords containing the pressed button (with a bitmask subset test) instead of every action.
+	 * @note Managed by BufferedInput, there usually isn't a need to use this directly!
+	 */
+	struct ChordIndex {
+		static constexpr size_t MaxButtons = 256;
+		using Mask = std::bitset<MaxButtons>;
+
+		// Rebuilds the index from the exclusive chords in the context
+		void Rebuild(InputContext& context);
+		// Updates every exclusive chord from the snapshot, invoking callbacks as chords are pressed and released
+		void Poll(const InputSnapshot& snapshot, TimerWheel* timers);
+
+		bool dirty = true; // When true the index is rebuilt before the next poll
+
+	protected:
+		friend struct BufferedInput;
+
+		struct Chord {
+			Mask mask;
+			size_t size;
+			Action* action;
+			std::string_view name;
+			std::vector<uint32_t> shadows; // Chords which are strict subsets of this chord (pressing this chord releases them)
+			bool active = false;
+		};
+
+		std::vector<Button> buttons; // Button represented by each bit
+		std::map<Button, uint32_t> bits;
+		std::vector<Chord> chords;
+		std::vector<std::vector<uint32_t>> byButton; // Chords containing each button, most specific first
+		Mask down;
+	};
+
+	/**
+	 * @brief The derived actions of a context sorted so that every action comes after the actions it is computed from.
+	 * 	Each derived action remembers how many times its inputs had changed when it was last computed, so unchanged actions are skipped with a few integer comparisons.
+	 * @note Managed by BufferedInput, there usually isn't a need to use this directly!
 	 */
-	struct BufferedInput {
+	struct DerivedGraph {
+		// Resolves the inputs of every derived action in the context and sorts them into dependency order
+		void Rebuild(InputContext& context);
+		// Recomputes every derived action whose inputs changed, invoking callbacks as their states change
+		void Evaluate();
+
+		bool dirty = true; // When true the graph is rebuilt before the next poll
+
+	protected:
+		friend struct BufferedInput;
+
+		struct Node {
+			Action* action;
+			std::string_view name;
+			std::vector<Action*> inputs;
+			std::vector<uint32_t> seen; // Change counters of the inputs when the action was last computed
+			std::vector<Vector2> states; // Scratch space passed to the combine function
+			bool primed = false;
+		};
+
+		std::vector<Node> nodes; // In dependency order
+	};
+
+	/**
+	 * @brief A named layer of actions (ex. menu, gameplay, vehicle) which can be switched on and off as a whole
+	 */
+	struct InputContext {
 		// Map associating names with actions
 		std::map<std::string, Action> actions;
 
-		// Access to the action map via the input object itself
+		int priority = 0; // Enabled contexts are evaluated from highest to lowest priority
+		bool enabled = true; // Disabled contexts are skipped while polling, the first poll after a context is disabled releases its held actions (toggling this is all it takes to switch contexts)
+		bool consume = false; // When true, buttons bound to this context's actions appear released to every lower priority context
+
+		// Access to the action map via the context object itself
 		Action& operator[](const std::string& key) {
 			return actions[key];
 		}
 
-		// Function which updates the state of all actions in the `actions` map.
+		// Must be called after changing the buttons of an exclusive chord or the inputs of a derived action in place (adding, replacing, and removing actions is detected automatically)
+		void InvalidateBindings() { chords.dirty = derived.dirty = true; }
+
+		InputContext() = default;
+		InputContext(InputContext&& o) { *this = std::move(o); }
+		InputContext& operator=(InputContext&& o);
+		~InputContext();
+
+	protected:
+		friend struct BufferedInput;
+		ChordIndex chords;
+		DerivedGraph derived;
+		bool active = false; // True if the context was enabled as of the last poll
+
+		// Incremented by the context's actions whenever one of them is replaced, destroyed, or reconfigured
+		uint64_t generation = 0;
+		// Generation and size of the action map as of the last poll (actions added since then don't point at the generation yet, so they are noticed by the size)
+		uint64_t polledGeneration = 0;
+		size_t polledActions = 0;
+	};
+
+	/**
+	 * @brief Engine for editor style shortcuts made of a sequence of chords (ex. Ctrl+K followed by Ctrl+C).
+	 * 	Sequences are stored in a trie whose edges are keyed on chord bitmasks (in a single flat hash table), so each key press costs one lookup no matter how many sequences are registered.
+	 * 	When a sequence is also the prefix of a longer sequence, it triggers once the timeout elapses or a key which doesn't continue the longer sequence is pressed.
+	 */
+	struct ShortcutSequences {
+		static constexpr size_t MaxButtons = ChordIndex::MaxButtons;
+		using Mask = ChordIndex::Mask;
+		using Callback = Delegate<void(const std::string_view name)>;
+
+		double timeout = 1; // Seconds allowed between the chords of a sequence
+
+		/**
+		 * @brief Registers a sequence
+		 *
+		 * @param name the name passed to the callback when the sequence triggers
+		 * @param sequence the chords which must be pressed in order
+		 * @return Callback& the callback invoked when the sequence triggers (stays valid as more sequences are added)
+		 */
+		Callback& Add(std::string name, const std::vector<ButtonSet>& sequence);
+		// Removes every sequence
+		void Clear();
+
+		// Advances the sequences from the snapshot, invoking callbacks as sequences are completed
+		void Poll(const InputSnapshot& snapshot);
+		// Abandons any partially entered sequence
+		void Reset() { current = 0; }
+		// True while part of a sequence has been entered
+		bool Pending() const { return current != 0; }
+		// Time at which the partially entered sequence times out
+		double Deadline() const { return lastTime + timeout; }
+
+	protected:
+		struct Node {
+			std::string name;
+			Callback callback;
+			bool terminal = false;
+			bool leaf = true;
+			Mask childUnion; // Every button appearing in the chords which continue from this node
+		};
+		struct Edge {
+			uint32_t node;
+			Mask chord;
+			bool operator==(const Edge& o) const { return node == o.node && chord == o.chord; }
+		};
+		struct EdgeHash {
+			size_t operator()(const Edge& e) const { return std::hash<Mask>{}(e.chord) ^ (std::hash<uint32_t>{}(e.node) * 0x9e3779b97f4a7c15ull); }
+		};
+
+		// Advances the current node along the edge for the chord (returns false if there is no such edge)
+		bool Advance(const Mask& chord, double time);
+		void Trigger(uint32_t node);
+
+		std::deque<Node> nodes = {Node{}}; // Node 0 is the root
+		std::unordered_map<Edge, uint32_t, EdgeHash> edges;
+		std::vector<Button> buttons; // Button represented by each bit
+		std::map<Button, uint32_t> bits;
+		Mask down;
+		// Inputs held last poll, only the ones which changed since are looked at
+		decltype(InputSnapshot::keys) keys;
+		decltype(InputSnapshot::mouseButtons) mouseButtons;
+		std::array<uint32_t, InputSnapshot::MaxGamepads> gamepadButtons = {};
+		decltype(InputSnapshot::thresholds) thresholds;
+		// Bit + 1 representing each input (0 for inputs which aren't part of a sequence)
+		std::array<uint16_t, InputSnapshot::MaxKeyboardKeys> keyBits = {};
+		std::array<uint16_t, InputSnapshot::MaxMouseButtons> mouseBits = {};
+		std::array<std::array<uint16_t, InputSnapshot::MaxGamepadButtons>, InputSnapshot::MaxGamepads> gamepadBits = {};
+		std::array<uint16_t, InputSnapshot::MaxThresholds> thresholdBits = {};
+		uint32_t current = 0;
+		double lastTime = 0;
+	};
+
+	struct BufferedInput;
+
+	/**
+	 * @brief A set of new bindings for existing actions, built on any thread and then published to a BufferedInput (see BufferedInput::PublishBindings).
+	 * 	Only the bindings of the prototypes are used (which buttons, axes, or derived inputs feed the action), the actions keep their state and callbacks.
+	 *
+	 * ex. raylib::BindingTable table; table.Bind("jump", raylib::Action::key(KEY_SPACE)).Bind("move", raylib::Action::wasd()); input.PublishBindings(std::move(table));
+	 */
+	struct BindingTable {
+		/**
+		 * @brief Rebinds an action
+		 *
+		 * @param name the name of the action (actions which don't exist when the table is applied are skipped)
+		 * @param prototype an action of the same type holding the new bindings (ex. Action::key(KEY_SPACE))
+		 * @param context the name of the context the action belongs to (empty for the input's own actions)
+		 * @return BindingTable& this table (for chaining)
+		 */
+		BindingTable& Bind(std::string name, Action prototype, std::string context = {}) {
+			entries.push_back({std::move(context), std::move(name), std::move(prototype)});
+			return *this;
+		}
+
+		bool empty() const { return entries.empty(); }
+
+	protected:
+		friend struct BufferedInput;
+		friend struct BindingMailbox;
+		struct Entry {
+			std::string context, name;
+			Action prototype; // Holds the replaced bindings once applied (so they are freed with the table)
+		};
+		std::vector<Entry> entries;
+		BindingTable* next = nullptr; // Next table in a mailbox's list of retired tables
+	};
+
+	/**
+	 * @brief Lock free handoff of binding tables between writer threads and the polling thread.
+	 * 	Writers swap their table into the pending slot, the polling thread swaps it out (once per poll) and pushes it onto the retired list once applied.
+	 * 	Every table is freed by the next writer (or the mailbox itself), the polling thread never frees one.
+	 * @note Managed by BufferedInput, there usually isn't a need to use this directly!
+	 */
+	struct BindingMailbox {
+		BindingMailbox() = default;
+		// Moving is only safe while no other thread is publishing
+		BindingMailbox(BindingMailbox&& o) : pending(o.pending.exchange(nullptr)), retired(o.retired.exchange(nullptr)) {}
+		BindingMailbox& operator=(BindingMailbox&& o) {
+			delete pending.exchange(o.pending.exchange(nullptr));
+			Free(retired.exchange(o.retired.exchange(nullptr)));
+			return *this;
+		}
+		~BindingMailbox() {
+			delete pending.load();
+			Free(retired.load());
+		}
+
+		// Publishes a table (replacing any table which wasn't taken yet), can be called from any thread
+		void Publish(BindingTable table);
+		// Takes the most recently published table (null if there isn't one), must only be called by the polling thread
+		BindingTable* Take() { return pending.load(std::memory_order_relaxed) ? pending.exchange(nullptr, std::memory_order_acquire) : nullptr; }
+		// Hands a taken table back to be freed by the next writer, must only be called by the polling thread
+		void Retire(BindingTable* table);
+
+	protected:
+		// Frees a list of retired tables
+		static void Free(BindingTable* table);
+
+		std::atomic<BindingTable*> pending = nullptr;
+		std::atomic<BindingTable*> retired = nullptr; // Only ever pushed onto by the polling thread and taken as a whole by writers (so the list can't suffer from ABA)
+	};
+
+	/**
+	 * @brief Awaitable which suspends a coroutine until an action is pressed, released, held for a duration, or reaches a value (created by BufferedInput::Pressed and friends).
+	 * 	Suspended coroutines are kept in a list on their action, so they cost nothing until that action changes; they are resumed at the end of the BufferedInput::PollEvents which satisfied them.
+	 * 	co_await evaluates to the state of the action when the condition was met.
+	 * @note Waiting coroutines must be destroyed before the BufferedInput they wait on, coroutines waiting on an action which is removed are never resumed
+	 */
+	struct ActionAwaiter: public TimedBehaviour {
+		enum class Condition : uint8_t {
+			Pressed, // The action's state becomes non zero
+			Released, // The action's state becomes zero
+			Held, // The action's state stays non zero for duration seconds (counting from when the coroutine started waiting if already held)
+			Reached, // The length of the action's state is at least threshold (immediately if it already is)
+		};
+
+		ActionAwaiter(BufferedInput& input, Action& action, Condition condition, float value = 0)
+			: input(&input), condition(condition), value(value) { owner = &action; }
+		~ActionAwaiter();
+
+		bool await_ready() const;
+#ifdef __cpp_impl_coroutine
+		void await_suspend(std::coroutine_handle<> handle);
+#endif
+		Vector2 await_resume() const { return result; }
+
+		void Expire(std::string_view name, double time) override;
+
+	protected:
+		friend struct Action;
+		friend struct BufferedInput;
+
+		// Checks the condition against a change in the action's state
+		void Update(Vector2 previous, Vector2 state);
+		// Removes this awaiter from its action's list and queues the coroutine to be resumed
+		void Fire(Vector2 state);
+		void Unlink();
+
+		BufferedInput* input;
+		Condition condition;
+		float value; // Duration or threshold
+		void* handle = nullptr; // Address of the suspended coroutine (kept type erased so the layout doesn't depend on coroutine support)
+		ActionAwaiter *next = nullptr, *previous = nullptr;
+		bool linked = false, queued = false;
+		Vector2 result = {0, 0};
+	};
+
+	/**
+	 * @brief Coroutine type for input driven scripts (ex. tutorials, cutscene skips, menu flows), which can co_await actions and other tasks.
+	 * 	The coroutine starts running as soon as it is called, destroying the task destroys the coroutine (and stops it from waiting).
+	 * 	An exception thrown by the coroutine finishes it and is rethrown to whoever awaits the task (top level tasks can check with Rethrow).
+	 *
+	 * ex. raylib::InputTask Tutorial(raylib::BufferedInput& input) { co_await input.Pressed("jump"); co_await input.HeldFor("crouch", 1); }
+	 */
+#ifdef __cpp_impl_coroutine
+	struct InputTask {
+		struct promise_type {
+			std::coroutine_handle<> continuation; // Coroutine awaiting this task
+			std::exception_ptr exception; // Exception the coroutine finished with
+
+			InputTask get_return_object() { return InputTask{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+			std::suspend_never initial_suspend() noexcept { return {}; }
+			auto final_suspend() noexcept {
+				// Finished tasks stay suspended (so Done can be queried) and resume whoever is awaiting them
+				struct Final {
+					bool await_ready() noexcept { return false; }
+					std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+						if(auto continuation = handle.promise().continuation) return continuation;
+						return std::noop_coroutine();
+					}
+					void await_resume() noexcept {}
+				};
+				return Final{};
+			}
+			void return_void() {}
+			// Kept for the awaiting coroutine (throwing here would unwind through whichever poll resumed the coroutine and never resume the awaiting one)
+			void unhandled_exception() { exception = std::current_exception(); }
+		};
+
+		InputTask() = default;
+		explicit InputTask(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+		InputTask(const InputTask&) = delete;
+		InputTask(InputTask&& o) : handle(std::exchange(o.handle, nullptr)) {}
+		InputTask& operator=(const InputTask&) = delete;
+		InputTask& operator=(InputTask&& o) {
+			if(this != &o) {
+				if(handle) handle.destroy();
+				handle = std::exchange(o.handle, nullptr);
+			}
+			return *this;
+		}
+		~InputTask() { if(handle) handle.destroy(); }
+
+		// True once the coroutine has finished (or if there isn't one)
+		bool Done() const { return !handle || handle.done(); }
+		// Rethrows the exception the coroutine finished with (does nothing if it hasn't finished or finished normally)
+		void Rethrow() const { if(handle && handle.promise().exception) std::rethrow_exception(handle.promise().exception); }
+
+		// Awaiting a task suspends until it finishes
+		bool await_ready() const noexcept { return Done(); }
+		void await_suspend(std::coroutine_handle<> awaiting) { handle.promise().continuation = awaiting; }
+		void await_resume() const { Rethrow(); }
+
+	protected:
+		std::coroutine_handle<promise_type> handle = nullptr;
+	};
+#endif // __cpp_impl_coroutine
+
+	/**
+	 * @brief InputManager which is responsible for a map of actions and updating their values
+	 * @note The input manager is itself the base context (priority 0), additional contexts can be layered above or below it
+	 */
+	struct BufferedInput: public InputContext {
+		BufferedInput() = default;
+		// Detaches the tracked actions from the state arrays (which are destroyed before the actions)
+		~BufferedInput();
+		// Pending timers and coroutines point back into the input, so it stays where it was created
+		BufferedInput(const BufferedInput&) = delete;
+		BufferedInput(BufferedInput&&) = delete;
+		BufferedInput& operator=(const BufferedInput&) = delete;
+		BufferedInput& operator=(BufferedInput&&) = delete;
+
+		// Additional named contexts
+		std::map<std::string, InputContext> contexts;
+
+		// Mapping from the gamepad ids this input's actions are bound to onto physical gamepads (ex. player two's gamepad 0 is physical gamepad 1)
+		InputSnapshot::GamepadMapping gamepadMapping = InputSnapshot::IdentityMapping;
+
+		/**
+		 * @brief Creates (or reconfigures) a named context
+		 *
+		 * @param name the name of the context
+		 * @param priority contexts with a higher priority are evaluated first (the base context has priority 0)
+		 * @param consume when true, buttons bound to the context hide from lower priority contexts
+		 * @param enabled whether the context starts enabled
+		 * @return InputContext& the context
+		 */
+		InputContext& AddContext(const std::string& name, int priority = 0, bool consume = false, bool enabled = true) {
+			auto& context = contexts[name];
+			context.priority = priority;
+			context.consume = consume;
+			context.enabled = enabled;
+			return context;
+		}
+
+		/**
+		 * @brief Enables a context and remembers it so that PopContext can disable it again
+		 *
+		 * @param name the name of the context to enable (must already exist)
+		 * @return InputContext& the context
+		 */
+		InputContext& PushContext(const std::string& name) {
+			auto& context = contexts.at(name);
+			context.enabled = true;
+			pushed.push_back(name);
+			return context;
+		}
+
+		/**
+		 * @brief Disables the most recently pushed context (which hasn't already been popped)
+		 */
+		void PopContext() {
+			if(pushed.empty()) return;
+			if(auto context = contexts.find(pushed.back()); context != contexts.end())
+				context->second.enabled = false;
+			pushed.pop_back();
+		}
+
+		// Multi-chord shortcuts (ex. Ctrl+K, Ctrl+C) evaluated after every context
+		ShortcutSequences sequences;
+
+		/**
+		 * @brief Starts mirroring an action's state into the per frame state arrays (see States)
+		 *
+		 * @param name the name of the action (must already exist)
+		 * @param context the name of the context the action belongs to (empty for this input's own actions)
+		 * @return ActionStates::Handle the index of the action in the state arrays (the same handle is returned if the action is already tracked)
+		 */
+		ActionStates::Handle GetHandle(const std::string& name, const std::string& context = {});
+		// Per frame state of every action a handle has been requested for, updated by PollEvents
+		const ActionStates& States() const { return states; }
+		// Shorthand for States().Get(handle)
+		ActionStates::State GetState(ActionStates::Handle handle) const { return states.Get(handle); }
+
+		/**
+		 * @brief Publishes new bindings from any thread, they are applied all at once at the start of the next poll (so a poll never sees half of a rebind).
+		 * 	The polling thread never takes a lock, if several tables are published between polls only the last one is applied.
+		 * @note Apart from this, actions and contexts must only be modified by the polling thread
+		 *
+		 * @param table the new bindings
+		 */
+		void PublishBindings(BindingTable table) { rebinds.Publish(std::move(table)); }
+
+		// Returns the action a handle was issued for (the action must still exist)
+		Action& GetAction(ActionStates::Handle handle) {
+			Action* action = states.owners.at(handle);
+			assert(action && "The action this handle was issued for no longer exists");
+			return *action;
+		}
+
+		/**
+		 * @brief Awaitables which suspend a coroutine until an action changes (see ActionAwaiter).
+		 * 	ex. co_await input.Pressed(jump); co_await input.HeldFor("skip", 2); co_await input.Reached(throttle, .9);
+		 */
+		ActionAwaiter Pressed(ActionStates::Handle handle) { return {*this, GetAction(handle), ActionAwaiter::Condition::Pressed}; }
+		ActionAwaiter Pressed(const std::string& name, const std::string& context = {}) { return {*this, FindAction(name, context), ActionAwaiter::Condition::Pressed}; }
+		ActionAwaiter Released(ActionStates::Handle handle) { return {*this, GetAction(handle), ActionAwaiter::Condition::Released}; }
+		ActionAwaiter Released(const std::string& name, const std::string& context = {}) { return {*this, FindAction(name, context), ActionAwaiter::Condition::Released}; }
+		ActionAwaiter HeldFor(ActionStates::Handle handle, float seconds) { return {*this, GetAction(handle), ActionAwaiter::Condition::Held, seconds}; }
+		ActionAwaiter HeldFor(const std::string& name, float seconds, const std::string& context = {}) { return {*this, FindAction(name, context), ActionAwaiter::Condition::Held, seconds}; }
+		ActionAwaiter Reached(ActionStates::Handle handle, float threshold) { return {*this, GetAction(handle), ActionAwaiter::Condition::Reached, threshold}; }
+		ActionAwaiter Reached(const std::string& name, float threshold, const std::string& context = {}) { return {*this, FindAction(name, context), ActionAwaiter::Condition::Reached, threshold}; }
+
+		// Profiling counters for PollEvents (always zero unless compiled with BUFFERED_RAYLIB_PROFILING), per action counters are available from Action::GetStats
+		const PollStats& GetPollStats() const { return pollStats; }
+		// Resets the poll counters and the counters of every action in every context
+		void ResetStats();
+		// Clears the latency histograms of every action in every context (see Action::GetLatency)
+		void ResetLatency();
+
+		/**
+		 * @brief What happens to held actions when the window loses focus (while unfocused, polls are skipped unless whileUnfocused is set)
+		 */
+		enum class FocusPolicy : uint8_t {
+			Keep, // Actions keep their state until focus returns
+			Release, // Held actions are released (invoking their callbacks) as soon as focus is lost
+			Reset, // Held actions are returned to rest without invoking their callbacks
+		} focusPolicy = FocusPolicy::Release;
+
+		/**
+		 * @brief Releases every held action in every context in a single pass (ex. when the window loses focus or a pause menu opens).
+		 * 	Buttons are released and sticks centered, while positions and accumulated sums are kept; pending timers, chords, and partially entered sequences are abandoned.
+		 *
+		 * @param notify whether the callbacks of the released actions are invoked
+		 */
+		void ReleaseAll(bool notify = true);
+
+		// When set, the state arrays are published here after every poll so other threads can read them (see PublishedStates)
+		PublishedStates* published = nullptr;
+
+		// When true, polls return immediately if the input is idle and nothing changed since the last poll.
+		// Off by default since edits made directly to an action's data go unnoticed until Invalidate is called
+		bool skipIdleFrames = false;
+		// Forces the next poll to evaluate every action (needed after modifying an action's data directly, changes made through Action's setters are noticed automatically)
+		void Invalidate() {
+			invalidated = true;
+			analog.Invalidate();
+		}
+		// True if the last poll was skipped since the input was idle
+		bool WasIdle() const { return idle; }
+
+		/**
+		 * @brief Checks if a timer (hold, multi-tap, repeat) or a partially entered shortcut sequence is pending.
+		 * 	While nothing is pending, an idle frame can't produce events so the app may block waiting for input (ex. with EnableEventWaiting).
+		 *
+		 * @return True if something will happen without further input, false otherwise.
+		 */
+		bool HasPendingTimers() const { return timers.Pending() || sequences.Pending(); }
+		// Time (GetTime) at which the earliest pending timer or sequence expires (infinity when nothing is pending), the longest the app may wait for input before polling again
+		double NextDeadline() const { return std::min(timers.NextDeadline(), sequences.Pending() ? sequences.Deadline() : std::numeric_limits<double>::infinity()); }
+
+		// Function which captures a snapshot of the input devices and updates the state of all actions in every enabled context.
 		void PollEvents(bool whileUnfocused = false);
+		// Function which updates the state of all actions in every enabled context from a snapshot (which may be shared with other BufferedInputs).
+		void PollEvents(const InputSnapshot& snapshot, bool whileUnfocused = false);
+
+	protected:
+		// Updates the state of all actions in every enabled context (PollEvents without publishing)
+		void PollActions(const InputSnapshot& snapshot, bool whileUnfocused);
+		// Updates all of the actions in a single context
+		void PollContext(InputContext& context, const InputSnapshot& snapshot);
+		// Releases every held action in a single context (see ReleaseAll)
+		void ReleaseContext(InputContext& context, bool notify);
+		friend struct ActionAwaiter;
+
+		// Looks up an action by name (the action must exist)
+		Action& FindAction(const std::string& name, const std::string& context) { return (context.empty() ? actions : contexts.at(context).actions).at(name); }
+		// Resumes every coroutine whose condition was met
+		void ResumeReady();
+		// Applies the most recently published binding table (if there is one)
+		void ApplyBindings();
+
+		// Checks if polling the snapshot would change nothing (the input and bindings are the same as the last poll, which produced no events)
+		bool IsIdle(const InputSnapshot& snapshot);
+
+		std::vector<std::string> pushed; // Stack of contexts enabled by PushContext
+		std::vector<InputContext*> order; // Enabled contexts sorted by priority (rebuilt every poll so contexts can be freely added and removed)
+		AnalogBatch analog; // Every processed analog action gets processed together after the rest of the actions have been pumped
+		TimerWheel timers; // Every pending timer of every context
+		InputSnapshot captured; // Snapshot filled in when this input captures its own device state
+		InputSnapshot remapped; // Snapshot with gamepadMapping applied (only used when the mapping isn't the identity)
+		InputSnapshot working; // Snapshot which consuming contexts remove their buttons from
+		ActionStates states; // Mirrored state of every action with a handle
+		PollStats pollStats;
+
+		// Idle frame detection
+		InputSnapshot last; // Snapshot of the last full poll
+		InputSnapshot::GamepadMapping lastMapping = InputSnapshot::IdentityMapping;
+		std::vector<int64_t> layout, lastLayout; // Enabled state, priority, size, and generation of every context (to notice contexts being toggled, added, removed, or rebound)
+		bool invalidated = true, changed = true, idle = false;
+		bool focused = true; // Focus as of the last poll
+
+		std::vector<ActionAwaiter*> ready; // Coroutines to resume at the end of the poll (null once their awaiter is destroyed)
+		double now = 0; // Time of the snapshot being polled
+		BindingMailbox rebinds;
 	};
 
-}
\ No newline at end of file
+	/**
+	 * @brief Pool of worker threads which polls many BufferedInputs at once (ex. one per bot agent on a headless server).
+	 * 	Inputs are split evenly between the workers, and workers which run out steal half of the remaining inputs of another worker, so uneven workloads still balance.
+	 * 	Every callback invocation is also recorded, and merged in input order once every input has been polled, so the merged events are the same no matter how the work was split.
+	 * @note Callbacks are invoked on the worker threads, so they must only touch data belonging to their own input
+	 */
+	struct InputPool {
+		/**
+		 * @brief Starts the worker threads
+		 *
+		 * @param threads the number of threads which evaluate inputs (including the thread which calls PollEvents, default every core)
+		 */
+		explicit InputPool(size_t threads = std::thread::hardware_concurrency());
+		InputPool(const InputPool&) = delete;
+		InputPool& operator=(const InputPool&) = delete;
+		~InputPool();
+
+		bool recordEvents = true; // When false, events are only delivered to callbacks (Events stays empty)
+
+		/**
+		 * @brief Polls every input from its own snapshot in parallel, returning once all of them are done.
+		 *
+		 * @param inputs the inputs to poll
+		 * @param snapshots the snapshot to poll each input with (snapshots[i] is used by inputs[i])
+		 * @param whileUnfocused whether inputs are polled even if their snapshot isn't focused
+		 */
+		void PollEvents(std::span<BufferedInput* const> inputs, std::span<const InputSnapshot> snapshots, bool whileUnfocused = false);
+		// Every event from the last PollEvents, ordered by input and then by the order each input produced them
+		const std::vector<InputEvent>& Events() const { return events; }
+
+		/**
+		 * @brief Invokes a function once for every index in [0, count) spread across the workers, returning once every invocation is done
+		 * 	If any invocation throws, the others still run and the first exception is rethrown on the calling thread
+		 *
+		 * @param count the number of indices
+		 * @param f the function to invoke, signature: [](size_t index) -> void
+		 */
+		void ForEach(size_t count, const std::function<void(size_t index)>& f);
+
+		size_t Threads() const { return workers.size() + 1; }
+
+	protected:
+		// Range of indices left for a worker, packed (begin in the low half, end in the high half) so that it can be claimed from and stolen with a single compare and swap
+		struct alignas(64) Range {
+			std::atomic<uint64_t> bounds = 0;
+		};
+
+		// Evaluates indices until every range is empty
+		void Work(size_t worker);
+		// Claims the next index from a worker's own range
+		bool Pop(size_t worker, size_t& index);
+		// Moves the back half of another worker's range into this worker's range, claiming its first index
+		bool Steal(size_t worker, size_t& index);
+
+		std::vector<std::thread> workers;
+		std::unique_ptr<Range[]> ranges;
+		std::mutex mutex;
+		std::condition_variable started, finished;
+		const std::function<void(size_t)>* job = nullptr;
+		uint64_t jobCount = 0; // Incremented for every job (workers wait for it to change)
+		size_t active = 0; // Workers still running the current job
+		std::exception_ptr error; // First exception thrown by the current job
+		bool stopping = false;
+
+		std::vector<std::vector<InputEvent>> logs; // Events of each input
+		std::vector<InputEvent> events;
+	};
+
+
+	/**
+	 * @brief Immutable copy of the bindings of a context's actions, which any number of ReplayBatches (on any number of threads) can share.
+	 * 	Only actions whose state depends on nothing but the current frame and their own history are copied: buttons, axes, vectors, and multi buttons without processors, interactions, or repeat.
+	 * 	Exclusive chords are evaluated as plain combos, and derived actions are skipped.
+	 */
+	struct ReplayBindings {
+		/**
+		 * @brief Copies the bindings of the supported actions of a context
+		 * @note The accumulated sums of the context's actions aren't copied, streams start every sum at zero (see SetInitial)
+		 *
+		 * @param context the context (or BufferedInput) whose actions are copied
+		 */
+		explicit ReplayBindings(const InputContext& context);
+
+		/**
+		 * @brief Declares the accumulated sum an accumulating or clamped analog action starts every stream with (ex. a camera angle restored from a save)
+		 *
+		 * @param binding the index of the action
+		 * @param value the starting sum (only x is used by axes, ignored for every other type of action)
+		 * @return ReplayBindings& these bindings (for chaining)
+		 */
+		ReplayBindings& SetInitial(size_t binding, Vector2 value);
+
+		size_t size() const { return actions.size(); }
+		// Name of the action with index binding
+		const std::string& Name(size_t binding) const { return names[binding]; }
+		// Index of the action with a name (size() if it wasn't copied)
+		size_t Find(std::string_view name) const { return std::find(names.begin(), names.end(), name) - names.begin(); }
+
+	protected:
+		friend struct ReplayBatch;
+		std::vector<std::string> names;
+		std::vector<Action> actions; // Callback free copies of the actions
+	};
+
+	/**
+	 * @brief Replays many independent recorded input streams (ex. one per player for server side validation) through a shared set of bindings, producing the same action states the clients saw.
+	 * 	The per stream state is a pair of vectors per action, stored action major, so each frame is evaluated one action at a time across every stream while that action's bindings stay in cache.
+	 * 	Every stream keeps a running checksum of its events (frame, action, and state), which can be compared against the checksum a client reports.
+	 */
+	struct ReplayBatch {
+		/**
+		 * @brief A state change produced by a replay
+		 */
+		struct Event {
+			uint32_t stream;
+			uint32_t binding; // Index of the action in the bindings
+			Vector2 state;
+			Vector2 delta;
+		};
+
+		/**
+		 * @brief Creates the state for a number of streams (each starts where a freshly created action would, with the sums declared by ReplayBindings::SetInitial)
+		 *
+		 * @param bindings the bindings every stream is evaluated against
+		 * @param streams the number of streams
+		 */
+		ReplayBatch(std::shared_ptr<const ReplayBindings> bindings, size_t streams);
+
+		bool recordEvents = false; // When true, Events holds the changes of the last Process (ordered by action, then stream)
+
+		/**
+		 * @brief Advances every stream by one frame
+		 *
+		 * @param frames the next frame of each stream (frames[i] advances stream i), null skips the stream this time
+		 */
+		void Process(std::span<const InputSnapshot* const> frames);
+		// Restarts a stream from the initial state (ex. for a new player), independent of anything the live actions have done since
+		void Reset(size_t stream);
+
+		size_t Streams() const { return streams.size(); }
+		// Running checksum of every event a stream produced
+		uint64_t Checksum(size_t stream) const { return streams[stream].checksum; }
+		// Number of frames and events a stream has processed
+		uint64_t Frames(size_t stream) const { return streams[stream].frames; }
+		uint64_t EventCount(size_t stream) const { return streams[stream].events; }
+		// The state of an action in a stream (as the action's callback last reported it)
+		Vector2 GetState(size_t stream, size_t binding) const;
+		const std::vector<Event>& Events() const { return events; }
+
+	protected:
+		struct Stream {
+			uint64_t checksum = 0;
+			uint64_t frames = 0;
+			uint64_t events = 0;
+		};
+
+		// Records a change in the state of an action in a stream
+		void Emit(size_t stream, uint32_t binding, Vector2 state, Vector2 delta);
+		size_t Slot(size_t stream, size_t binding) const { return binding * streams.size() + stream; }
+
+		std::shared_ptr<const ReplayBindings> bindings;
+		std::vector<Stream> streams;
+		std::vector<Vector2> last; // The last state of each action (for button actions x holds the number of pressed buttons), indexed by Slot
+		std::vector<Vector2> accumulated; // Running sums of accumulating analog actions, indexed by Slot
+		std::vector<Event> events;
+	};
+}